@@ -6,13 +6,21 @@
 #include <iomanip>
 #include <ctime>
 #include <limits>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+#include <chrono>
 #include "include/crono_hash.h"
+#include "include/crono_file.h"
+#include "include/crono_pool.h"
 #include <oqs/sha3.h> // Für die Generierung eines sicheren Strings
 
 // Verhindert Konflikte mit den Windows-Makros min/max
 #define NOMINMAX
 #ifdef _WIN32
 #include <windows.h>
+#include <fcntl.h>
+#include <io.h>
 #endif
 
 // Sprachunterstützung: Enum und globale Variable
@@ -97,19 +105,29 @@ static Language select_language() {
 // Überschriebene Hilfefunktion zur Ausgabe der Kommandozeilenparameter
 static void print_usage() {
     if (currentLanguage == Language::DE) {
-        std::cout << "Usage: CronoHash [-i input_string] [-d binding_duration_ms] [-m mode] [-b bit_strength]\n";
+        std::cout << "Usage: CronoHash [-i input_string | -f file] [-d binding_duration_ms] [-m mode] [-b bit_strength] [--format encoding]\n";
         std::cout << "  -i : Input-String zum Hashen (Standard: \"CronoHash Prime Core v1\")\n";
+        std::cout << "  -f <datei|-> : Hasht den Inhalt der Datei bzw. von stdin; Durchsatz auf stderr\n";
         std::cout << "  -d : Temp-Binding-Dauer in Millisekunden (Standard: 0, kein Binding)\n";
         std::cout << "  -m : Mode (FAST, BALANCED, SECURE, ENTROPIC) (Standard: BALANCED)\n";
         std::cout << "  -b : Bitstärke (128, 256, 512, 1024, 2048) (Standard: 256)\n";
+        std::cout << "  --format : Ausgabeformat des Hashes (hex, base64url, base32) (Standard: hex)\n";
+        std::cout << "  --batch <datei|-> : Hasht jede Zeile der Datei bzw. von stdin, eine Ausgabezeile pro Eingabe\n";
+        std::cout << "  -0 : Eingaben im Batch-Modus durch NUL statt Zeilenumbruch getrennt\n";
+        std::cout << "  --jsonl : Batch-Ausgabe als JSON Lines mit Metadaten\n";
         std::cout << "  -h : Zeige diese Hilfemeldung an\n";
     }
     else {
-        std::cout << "Usage: CronoHash [-i input_string] [-d binding_duration_ms] [-m mode] [-b bit_strength]\n";
+        std::cout << "Usage: CronoHash [-i input_string | -f file] [-d binding_duration_ms] [-m mode] [-b bit_strength] [--format encoding]\n";
         std::cout << "  -i : Input string to hash (default: \"CronoHash Prime Core v1\")\n";
+        std::cout << "  -f <file|-> : Hash the contents of the file or stdin; throughput on stderr\n";
         std::cout << "  -d : Temp binding duration in milliseconds (default: 0, no binding)\n";
         std::cout << "  -m : Mode (FAST, BALANCED, SECURE, ENTROPIC) (default: BALANCED)\n";
         std::cout << "  -b : Bit strength (128, 256, 512, 1024, 2048) (default: 256)\n";
+        std::cout << "  --format : Output format of the hash (hex, base64url, base32) (default: hex)\n";
+        std::cout << "  --batch <file|-> : Hash every line of the file or stdin, one output line per input\n";
+        std::cout << "  -0 : Batch inputs are separated by NUL instead of newline\n";
+        std::cout << "  --jsonl : Write batch output as JSON Lines with metadata\n";
         std::cout << "  -h : Show this help message\n";
     }
 }
@@ -240,10 +258,191 @@ static unsigned int prompt_bit_strength() {
     }
 }
 
+// Liest durch delimiter getrennte Datensätze blockweise aus file. Die Views eines Aufrufs von next()
+// bleiben bis zum nächsten Aufruf gültig; der Puffer wächst nur für Datensätze, die nicht hineinpassen.
+class RecordReader {
+public:
+    RecordReader(std::FILE* file, char delimiter) : file_(file), delimiter_(delimiter), buffer_(1 << 20) {}
+
+    // Füllt records mit höchstens max Datensätzen; false, wenn die Eingabe erschöpft ist
+    bool next(std::vector<std::string_view>& records, std::size_t max) {
+        records.clear();
+        // Unverbrauchten Rest an den Pufferanfang schieben
+        if (begin_ > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+            end_ -= begin_;
+            scan_ -= begin_;
+            begin_ = 0;
+        }
+        while (records.size() < max) {
+            const char* found = static_cast<const char*>(std::memchr(buffer_.data() + scan_, delimiter_, end_ - scan_));
+            if (found != nullptr) {
+                add(records, static_cast<std::size_t>(found - buffer_.data()));
+                begin_ = scan_ = static_cast<std::size_t>(found - buffer_.data()) + 1;
+                continue;
+            }
+            scan_ = end_;
+            if (eof_) {
+                // Letzter Datensatz ohne abschließendes Trennzeichen
+                if (begin_ < end_)
+                    add(records, end_);
+                begin_ = scan_ = end_;
+                break;
+            }
+            // Nachladen würde den Puffer verschieben und bereits gelieferte Views ungültig machen
+            if (!records.empty())
+                break;
+            if (end_ == buffer_.size())
+                buffer_.resize(buffer_.size() * 2);
+            const std::size_t n = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+            end_ += n;
+            if (n == 0)
+                eof_ = true;
+        }
+        return !records.empty();
+    }
+
+private:
+    void add(std::vector<std::string_view>& records, std::size_t end) {
+        std::size_t length = end - begin_;
+        // Zeilenenden aus Windows-Dateien (CRLF) gehören nicht zum Datensatz
+        if (delimiter_ == '\n' && length > 0 && buffer_[begin_ + length - 1] == '\r')
+            length--;
+        records.emplace_back(buffer_.data() + begin_, length);
+    }
+
+    std::FILE* file_;
+    const char delimiter_;
+    std::vector<char> buffer_;
+    std::size_t begin_ = 0;  // Beginn des nächsten Datensatzes
+    std::size_t scan_ = 0;   // Bis hier ist kein Trennzeichen mehr zu finden
+    std::size_t end_ = 0;    // Ende der gelesenen Daten
+    bool eof_ = false;
+};
+
+// Batch-Modus: Datensätze blockweise auf dem Worker-Pool hashen und in Eingabereihenfolge über einen
+// großen Puffer ausgeben. Kurze Eingaben werden unverändert gehasht, damit jede Zeile reproduzierbar bleibt.
+static int run_batch(const char* path, char delimiter, bool jsonl, double binding_duration, CronoHash::CronoMode mode,
+    unsigned int bit_strength, CronoHash::Encoding format) {
+    const bool from_stdin = std::strcmp(path, "-") == 0;
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+    if (from_stdin)
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    std::FILE* input = from_stdin ? stdin : std::fopen(path, "rb");
+    if (input == nullptr) {
+        if (currentLanguage == Language::DE)
+            std::cerr << "Datei kann nicht geöffnet werden: " << path << "\n";
+        else
+            std::cerr << "Cannot open file: " << path << "\n";
+        return 1;
+    }
+
+    const std::size_t CHUNK_RECORDS = 4096;
+    const std::size_t FLUSH_BYTES = 1 << 20;
+    RecordReader reader(input, delimiter);
+    std::vector<std::string_view> records;
+    std::vector<CronoHash::HashResult> results;
+    std::string out;
+    out.reserve(FLUSH_BYTES + 4096);
+    bool ok = true;
+    while (ok && reader.next(records, CHUNK_RECORDS)) {
+        results.resize(records.size());
+        CronoUtils::WorkerPool::shared().parallel_for(records.size(), [&](std::size_t i) {
+            // Ein Hasher pro Thread: die Umgebungsentropie wird nicht für jeden Datensatz neu erhoben
+            thread_local CronoHash::Hasher hasher({}, CronoHash::CronoVersion::V3);
+            results[i] = hasher.hash_with_result(records[i].data(), records[i].size(), binding_duration, mode, bit_strength);
+            });
+        for (const auto& result : results) {
+            if (jsonl) {
+                CronoHash::append_json_line(out, result, format);
+            }
+            else {
+                const std::size_t at = out.size();
+                out.resize(at + CronoHash::encoded_length(format, result.digest.size()));
+                CronoHash::encode_into(std::span<char>(out.data() + at, out.size() - at), result.digest, format);
+                out += '\n';
+            }
+            if (out.size() >= FLUSH_BYTES) {
+                ok = std::fwrite(out.data(), 1, out.size(), stdout) == out.size();
+                out.clear();
+            }
+        }
+    }
+    if (ok && !out.empty())
+        ok = std::fwrite(out.data(), 1, out.size(), stdout) == out.size();
+    ok = std::fflush(stdout) == 0 && ok;
+    if (std::ferror(input))
+        ok = false;
+    if (!from_stdin)
+        std::fclose(input);
+    return ok ? 0 : 1;
+}
+
+// Gibt Hash und Metadaten eines Ergebnisses aus
+static void print_result(const CronoHash::HashResult& result, unsigned int bit_strength, CronoHash::Encoding format) {
+    std::string hash = result.encoded(format);
+    if (currentLanguage == Language::DE)
+        std::cout << bit_strength << "-Bit Hash: " << hash << std::endl;
+    else
+        std::cout << bit_strength << "-Bit hash: " << hash << std::endl;
+
+    std::string meta = CronoHash::to_json(result);
+    if (currentLanguage == Language::DE)
+        std::cout << "Metadaten: " << meta << std::endl;
+    else
+        std::cout << "Metadata: " << meta << std::endl;
+}
+
+// Datei-Modus: Inhalt über CronoHash::Stream hashen, ohne ihn in einen String zu kopieren. Der Durchsatz geht
+// nach stderr; der Anteil der Wartezeit zeigt, ob die Eingabe oder der Hash die Geschwindigkeit begrenzt.
+static int run_file(const char* path, double binding_duration, CronoHash::CronoMode mode, unsigned int bit_strength,
+    CronoHash::Encoding format) {
+    CronoHash::Stream stream(binding_duration, mode, bit_strength);
+    CronoHash::FileHashStats stats;
+    if (!CronoHash::absorb_file(stream, path, &stats)) {
+        if (currentLanguage == Language::DE)
+            std::cerr << "Datei kann nicht gelesen werden: " << path << "\n";
+        else
+            std::cerr << "Cannot read file: " << path << "\n";
+        return 1;
+    }
+    const auto absorbed = std::chrono::steady_clock::now();
+    CronoHash::HashResult result = stream.final();
+    const double final_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - absorbed).count();
+    print_result(result, bit_strength, format);
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    if (currentLanguage == Language::DE) {
+        report << "Eingelesen: " << stats.bytes << " Bytes in " << stats.total_ms << " ms (" << stats.megabytes_per_second() << " MB/s, "
+            << (stats.mapped ? "gemappt" : "gelesen") << ")\n";
+        report << "Hashen: " << stats.hash_ms << " ms, Warten auf Eingabe: " << stats.wait_ms << " ms, Seitenfehler mit Laufwerkszugriff: "
+            << stats.major_faults << ", Finalisierung: " << final_ms << " ms\n";
+    }
+    else {
+        report << "Read: " << stats.bytes << " bytes in " << stats.total_ms << " ms (" << stats.megabytes_per_second() << " MB/s, "
+            << (stats.mapped ? "mapped" : "streamed") << ")\n";
+        report << "Hashing: " << stats.hash_ms << " ms, waiting for input: " << stats.wait_ms << " ms, major page faults: "
+            << stats.major_faults << ", finalization: " << final_ms << " ms\n";
+    }
+    std::cerr << report.str();
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
-    // Konsole positionieren etc.
-    set_console_window(1066, 825, 1805, 873);
-    print_logo_and_developer_info();
+    // Im Batch-Modus enthält stdout ausschließlich Ergebnisse: kein Konsolenfenster, kein Logo
+    bool batch = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--batch") == 0)
+            batch = true;
+    }
+    std::ostream& notice = batch ? std::cerr : std::cout;
+    if (!batch) {
+        set_console_window(1066, 825, 1805, 873);
+        print_logo_and_developer_info();
+    }
 
     // Im interaktiven Modus: Sprachwahl durchführen
     if (argc == 1) {
@@ -254,6 +453,11 @@ int main(int argc, char* argv[]) {
     double binding_duration = 0.0;
     CronoHash::CronoMode mode = CronoHash::CronoMode::BALANCED;
     unsigned int bit_strength = 256;
+    CronoHash::Encoding format = CronoHash::Encoding::Hex;
+    const char* batch_path = nullptr;
+    const char* file_path = nullptr;
+    char delimiter = '\n';
+    bool jsonl = false;
     const size_t MIN_LENGTH = 8;
 
     // Kommandozeilenparameter verarbeiten
@@ -262,6 +466,9 @@ int main(int argc, char* argv[]) {
             if (std::strcmp(argv[i], "-i") == 0 && (i + 1) < argc) {
                 input = argv[++i];
             }
+            else if (std::strcmp(argv[i], "-f") == 0 && (i + 1) < argc) {
+                file_path = argv[++i];
+            }
             else if (std::strcmp(argv[i], "-d") == 0 && (i + 1) < argc) {
                 binding_duration = std::atof(argv[++i]);
             }
@@ -277,9 +484,9 @@ int main(int argc, char* argv[]) {
                     mode = CronoHash::CronoMode::ENTROPIC;
                 else {
                     if (currentLanguage == Language::DE)
-                        std::cout << "Unbekannter Mode. Standard BALANCED wird verwendet.\n";
+                        notice << "Unbekannter Mode. Standard BALANCED wird verwendet.\n";
                     else
-                        std::cout << "Unknown mode. Default BALANCED will be used.\n";
+                        notice << "Unknown mode. Default BALANCED will be used.\n";
                     mode = CronoHash::CronoMode::BALANCED;
                 }
             }
@@ -288,21 +495,39 @@ int main(int argc, char* argv[]) {
                 if (bit_strength != 128 && bit_strength != 256 && bit_strength != 512 &&
                     bit_strength != 1024 && bit_strength != 2048) {
                     if (currentLanguage == Language::DE)
-                        std::cout << "Ungültige Bitstärke. Standard 256 Bit wird verwendet.\n";
+                        notice << "Ungültige Bitstärke. Standard 256 Bit wird verwendet.\n";
                     else
-                        std::cout << "Invalid bit strength. Default 256 Bit will be used.\n";
+                        notice << "Invalid bit strength. Default 256 Bit will be used.\n";
                     bit_strength = 256;
                 }
             }
+            else if (std::strcmp(argv[i], "--format") == 0 && (i + 1) < argc) {
+                if (!CronoHash::parse_encoding(argv[++i], format)) {
+                    if (currentLanguage == Language::DE)
+                        notice << "Unbekanntes Format. Standard hex wird verwendet.\n";
+                    else
+                        notice << "Unknown format. Default hex will be used.\n";
+                    format = CronoHash::Encoding::Hex;
+                }
+            }
+            else if (std::strcmp(argv[i], "--batch") == 0 && (i + 1) < argc) {
+                batch_path = argv[++i];
+            }
+            else if (std::strcmp(argv[i], "-0") == 0) {
+                delimiter = '\0';
+            }
+            else if (std::strcmp(argv[i], "--jsonl") == 0) {
+                jsonl = true;
+            }
             else if (std::strcmp(argv[i], "-h") == 0) {
                 print_usage();
                 return 0;
             }
             else {
                 if (currentLanguage == Language::DE)
-                    std::cout << "Ungültiger Parameter.\n";
+                    notice << "Ungültiger Parameter.\n";
                 else
-                    std::cout << "Invalid parameter.\n";
+                    notice << "Invalid parameter.\n";
                 print_usage();
                 return 1;
             }
@@ -326,6 +551,11 @@ int main(int argc, char* argv[]) {
         bit_strength = prompt_bit_strength();
     }
 
+    if (batch_path != nullptr)
+        return run_batch(batch_path, delimiter, jsonl, binding_duration, mode, bit_strength, format);
+    if (file_path != nullptr)
+        return run_file(file_path, binding_duration, mode, bit_strength, format);
+
     if (input.length() < MIN_LENGTH) {
         if (currentLanguage == Language::DE)
             std::cout << "Input zu kurz. Generiere sicheren Input-String...\n";
@@ -338,17 +568,8 @@ int main(int argc, char* argv[]) {
             std::cout << "Generated input: " << input << "\n";
     }
 
-    std::string hash = CronoHash::hash(input.c_str(), input.length(), binding_duration, mode, bit_strength);
-    if (currentLanguage == Language::DE)
-        std::cout << bit_strength << "-Bit Hash: " << hash << std::endl;
-    else
-        std::cout << bit_strength << "-Bit hash: " << hash << std::endl;
-
-    std::string meta = CronoHash::hash_with_metadata(input.c_str(), input.length(), binding_duration, mode, bit_strength);
-    if (currentLanguage == Language::DE)
-        std::cout << "Metadaten: " << meta << std::endl;
-    else
-        std::cout << "Metadata: " << meta << std::endl;
-
+    // Ein einziger Durchlauf: Hash und Metadaten stammen aus demselben Ergebnis
+    CronoHash::HashResult result = CronoHash::hash_with_result(input.c_str(), input.length(), binding_duration, mode, bit_strength);
+    print_result(result, bit_strength, format);
     return 0;
 }
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace CronoUtils {
+
+    // Bump-Allocator für kurzlebige Puffer der Hash-Pipeline. Freigaben in umgekehrter Reihenfolge geben den
+    // Speicher sofort zurück, ScopedScratch setzt am Ende eines Aufrufs auf den Anfangsstand zurück.
+    // Reicht der Block nicht aus, wird ein größerer angefordert; wird die Arena auf den Anfang zurückgesetzt,
+    // werden die Blöcke zu einem einzigen zusammengefasst. Nach dem Aufwärmen fordert sie daher keinen Speicher mehr an.
+    // Nicht threadsicher – jeder Thread nutzt seine eigene Arena (thread_arena()).
+    class ScratchArena final : public std::pmr::memory_resource {
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 16 * 1024;
+
+        explicit ScratchArena(std::size_t capacity = DEFAULT_CAPACITY, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+        ~ScratchArena() override;
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        // Füllstand, auf den rewind() zurücksetzen kann
+        struct Mark {
+            std::size_t block = 0;
+            std::size_t offset = 0;
+        };
+        Mark mark() const { return Mark{ blocks_.size() - 1, offset_ }; }
+        void rewind(const Mark& mark);
+
+        std::size_t used() const;
+        std::size_t capacity() const;
+        uint64_t upstream_allocations() const { return upstream_allocations_; }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        struct Block {
+            unsigned char* data;
+            std::size_t size;
+        };
+        void add_block(std::size_t size);
+        void consolidate();
+
+        std::pmr::memory_resource* upstream_;
+        std::vector<Block> blocks_;   // Der letzte Block ist der aktive
+        std::size_t offset_ = 0;      // Füllstand des aktiven Blocks
+        uint64_t upstream_allocations_ = 0;
+    };
+
+    // Arena des aufrufenden Threads
+    ScratchArena& thread_arena();
+
+    // Ressource, aus der die Pipeline im aktuellen Thread Scratch-Puffer bezieht (Standard: thread_arena())
+    std::pmr::memory_resource* scratch_resource();
+
+    // Setzt für die Lebensdauer des Objekts die Scratch-Ressource des Threads (nullptr: unverändert lassen)
+    // und gibt am Ende alles frei, was währenddessen aus der Thread-Arena bezogen wurde.
+    class ScopedScratch {
+    public:
+        explicit ScopedScratch(std::pmr::memory_resource* resource = nullptr);
+        ~ScopedScratch();
+        ScopedScratch(const ScopedScratch&) = delete;
+        ScopedScratch& operator=(const ScopedScratch&) = delete;
+
+    private:
+        std::pmr::memory_resource* previous_;
+        ScratchArena::Mark mark_;
+    };
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "crono_pool.h"
+
+namespace CronoUtils {
+
+    struct BindingSchedulerStats {
+        uint64_t requests = 0;           // Bindungsanfragen insgesamt
+        uint64_t windows = 0;            // Geöffnete Abtastfenster
+        uint64_t coalesced = 0;          // Anfragen, die sich einem laufenden Fenster angeschlossen haben
+        unsigned int active_samplers = 0;
+        uint64_t samples = 0;            // Messwerte aller Fenster, von Pool-Samplern und anfragenden Threads
+    };
+
+    // Zentraler Scheduler für die adaptive Zeitbindung. Gleichzeitige Anfragen teilen sich ein Abtastfenster,
+    // das ein einziger Satz Sampler auf dem WorkerPool bedient; eine spätere Anfrage verlängert das Fenster
+    // bei Bedarf bis zu ihrem eigenen Ende. Jeder anfragende Thread tastet bis dahin selbst einen Slot des
+    // Fensters ab, damit die Bindung auch bei ausgelastetem Pool frische Messwerte enthält.
+    // Jede Anfrage kombiniert den Stand der gemeinsamen Samples zu ihrem Endzeitpunkt mit einem eigenen Wert.
+    class BindingScheduler {
+    public:
+        explicit BindingScheduler(WorkerPool& pool, unsigned int samplers = 0);   // 0 = hardware_concurrency()
+        ~BindingScheduler();
+        BindingScheduler(const BindingScheduler&) = delete;
+        BindingScheduler& operator=(const BindingScheduler&) = delete;
+
+        // Blockiert für duration_ms und liefert den Bindungsfaktor dieser Anfrage
+        uint64_t bind(double duration_ms);
+
+        BindingSchedulerStats stats() const;
+
+        // Scheduler auf WorkerPool::shared(); Grundlage von adaptive_binding_factor()
+        static BindingScheduler& shared();
+
+    private:
+        struct Window;
+        void sample(const std::shared_ptr<Window>& window, std::size_t slot);
+        void sample_once(Window& window, std::size_t slot);
+
+        WorkerPool& pool_;
+        const unsigned int samplers_;
+        mutable std::mutex mutex_;
+        std::condition_variable idle_;
+        std::shared_ptr<Window> current_;
+        uint64_t requests_ = 0;
+        uint64_t windows_ = 0;
+        uint64_t coalesced_ = 0;
+        unsigned int active_samplers_ = 0;
+        std::atomic<uint64_t> samples_{ 0 };
+    };
+}
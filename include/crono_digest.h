@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <span>
+#include <string>
+
+namespace CronoHash {
+
+    // Formatiert rohe Digest-Bytes als hexadezimale Zeichenkette (Kleinbuchstaben).
+    std::string to_hex(std::span<const std::byte> bytes);
+    // Wie oben, der String wird jedoch aus resource allokiert (z. B. CronoUtils::scratch_resource())
+    std::pmr::string to_hex(std::span<const std::byte> bytes, std::pmr::memory_resource* resource);
+
+    // Digest fester Größe als Werttyp: vergleichbar, sortierbar und als Schlüssel in
+    // std::unordered_map verwendbar, ohne den Umweg über Hex-Strings.
+    // Die Bytes liegen in derselben Reihenfolge vor wie die Zeichen der Hex-Ausgabe (Big-Endian je Wort).
+    template <unsigned Bits>
+    struct CronoDigest {
+        static_assert(Bits >= 64 && Bits % 64 == 0, "CronoDigest erwartet ein Vielfaches von 64 Bit");
+
+        static constexpr std::size_t size_bytes = Bits / 8;
+
+        std::array<std::byte, size_bytes> bytes{};
+
+        std::span<std::byte, size_bytes> span() { return bytes; }
+        std::span<const std::byte, size_bytes> span() const { return bytes; }
+
+        std::string to_hex() const { return CronoHash::to_hex(bytes); }
+
+        friend bool operator==(const CronoDigest& a, const CronoDigest& b) {
+            return std::memcmp(a.bytes.data(), b.bytes.data(), size_bytes) == 0;
+        }
+
+        // Lexikographische Ordnung – entspricht der Ordnung der Hex-Strings
+        friend std::strong_ordering operator<=>(const CronoDigest& a, const CronoDigest& b) {
+            int c = std::memcmp(a.bytes.data(), b.bytes.data(), size_bytes);
+            return c < 0 ? std::strong_ordering::less : (c > 0 ? std::strong_ordering::greater : std::strong_ordering::equal);
+        }
+    };
+}
+
+// Digests sind bereits gleichverteilt – die ersten 8 Bytes genügen als Hash-Wert
+template <unsigned Bits>
+struct std::hash<CronoHash::CronoDigest<Bits>> {
+    std::size_t operator()(const CronoHash::CronoDigest<Bits>& d) const noexcept {
+        std::uint64_t v;
+        std::memcpy(&v, d.bytes.data(), sizeof(v));
+        return static_cast<std::size_t>(v);
+    }
+};
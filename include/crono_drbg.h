@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace CronoEntropy {
+
+    // ChaCha20-DRBG mit Schlüsselwechsel nach jeder Pufferfüllung ("fast key erasure"): Ein Durchlauf erzeugt
+    // acht Blöcke, die ersten 32 Bytes werden zum neuen Schlüssel, der Rest wird ausgegeben und nach dem
+    // Lesen gelöscht. Systementropie wird nur beim Seeding gezogen – beim ersten Gebrauch, alle
+    // RESEED_INTERVAL Bytes und im Kindprozess nach fork(). Nicht threadsicher (siehe thread_drbg()).
+    class ChaCha20Drbg {
+    public:
+        static constexpr std::size_t SEED_BYTES = 32;
+        static constexpr uint64_t RESEED_INTERVAL = 1 << 20;
+
+        ChaCha20Drbg() = default;
+        ~ChaCha20Drbg();
+        ChaCha20Drbg(const ChaCha20Drbg&) = delete;
+        ChaCha20Drbg& operator=(const ChaCha20Drbg&) = delete;
+
+        // Fester Seed (Tests); ohne Aufruf seedet sich der DRBG beim ersten generate() aus dem System.
+        // Ein fester Seed gilt bis zum nächsten automatischen Reseeding.
+        void seed(const uint8_t* seed);
+        void generate(uint8_t* out, std::size_t length);
+
+        uint64_t reseeds() const { return reseeds_; }
+
+    private:
+        static constexpr std::size_t BLOCK_BYTES = 64;
+        static constexpr std::size_t BLOCKS = 8;
+
+        void reseed_from_system();
+        void refill();
+
+        uint32_t key_[8] = {};
+        uint8_t buffer_[BLOCKS * BLOCK_BYTES] = {};
+        std::size_t available_ = 0;          // Ungelesene Bytes am Ende von buffer_
+        uint64_t bytes_since_seed_ = 0;
+        uint64_t fork_generation_ = 0;
+        uint64_t reseeds_ = 0;
+        bool seeded_ = false;
+    };
+
+    // DRBG des aufrufenden Threads
+    ChaCha20Drbg& thread_drbg();
+
+    // OQS_randombytes ohne aktive Umleitung: Bytes aus dem DRBG des aufrufenden Threads
+    void drbg_random_bytes(uint8_t* out, std::size_t length);
+
+    // Direkter Zugriff auf die Zufallsquelle des Betriebssystems (BCryptGenRandom, getrandom, /dev/urandom)
+    void system_random_bytes(uint8_t* out, std::size_t length);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CronoHash {
+
+    // Textkodierungen für rohe Digests. Alle Varianten sind URL-sicher und ohne Padding.
+    // Hex:       Kleinbuchstaben; beim Dekodieren sind auch Großbuchstaben erlaubt.
+    // Base64Url: RFC 4648 §5 ('-' und '_' statt '+' und '/').
+    // Base32:    Crockford-Alphabet (0-9, A-Z ohne I, L, O, U); beim Dekodieren ohne Beachtung der
+    //            Groß-/Kleinschreibung, O wird als 0 und I/L werden als 1 gelesen. Trennstriche sind nicht erlaubt.
+    // Beim Dekodieren müssen ungenutzte Bits der letzten Gruppe null sein, damit jeder Digest genau eine
+    // gültige Darstellung hat.
+    enum class Encoding {
+        Hex,
+        Base64Url,
+        Base32
+    };
+
+    const char* encoding_name(Encoding encoding);   // "hex", "base64url", "base32"
+    // Liest einen Namen wie von encoding_name(); false bei unbekanntem Namen
+    bool parse_encoding(std::string_view name, Encoding& encoding);
+
+    // Anzahl Zeichen für bytes Eingabebytes
+    std::size_t encoded_length(Encoding encoding, std::size_t bytes);
+    // Anzahl Bytes für chars Zeichen; 0, wenn keine gültige Kodierung diese Länge haben kann
+    std::size_t decoded_length(Encoding encoding, std::size_t chars);
+
+    // Schreibt encoded_length() Zeichen nach out. Liefert die Anzahl geschriebener Zeichen oder 0, falls out zu klein ist.
+    std::size_t encode_into(std::span<char> out, std::span<const std::byte> bytes, Encoding encoding);
+    std::string encode(std::span<const std::byte> bytes, Encoding encoding);
+    std::pmr::string encode(std::span<const std::byte> bytes, Encoding encoding, std::pmr::memory_resource* resource);
+
+    // Schreibt decoded_length() Bytes nach out. Liefert die Anzahl geschriebener Bytes oder 0 bei ungültiger
+    // Länge, ungültigen Zeichen oder zu kleinem out.
+    std::size_t decode_into(std::span<std::byte> out, std::string_view text, Encoding encoding);
+    // Leerer Vektor bei ungültiger Eingabe
+    std::vector<std::byte> decode(std::string_view text, Encoding encoding);
+
+    // Kernel-Variante der Kodierer, beim Laden per CPUID gewählt
+    enum class EncodingLevel {
+        Scalar,
+        SSSE3,
+        AVX2
+    };
+    EncodingLevel encoding_level();
+    // Erzwingt eine Variante (z. B. für Tests); false, wenn die CPU sie nicht unterstützt.
+    // Darf parallel zu laufenden Kodierungen aufgerufen werden.
+    bool force_encoding_level(EncodingLevel level);
+}
@@ -0,0 +1,222 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CronoEntropy {
+
+    // Zeitquellen der Hash-Pipeline (TSC, Systemzeit, Steady Clock)
+    class ClockSource {
+    public:
+        virtual ~ClockSource() = default;
+        virtual uint64_t tsc() = 0;
+        virtual uint64_t nano() = 0;     // Systemzeit in ns seit Epoch
+        virtual uint64_t steady() = 0;   // Monotone Zeit in ns
+    };
+
+    // Entropiequellen der Hash-Pipeline. random_bytes() bedient zusätzlich alle OQS_randombytes-Aufrufe
+    // innerhalb der Kyber-Runde (siehe ScopedRandomSource).
+    class EntropyProvider {
+    public:
+        virtual ~EntropyProvider() = default;
+        virtual void random_bytes(uint8_t* out, std::size_t length) = 0;
+        virtual uint64_t ram_fingerprint() = 0;
+        virtual uint64_t cache_noise() = 0;
+        virtual uint64_t ghost_salt() = 0;
+        virtual uint64_t memory_walk() = 0;
+        virtual uint64_t binding_factor(double duration_ms) = 0;
+
+        // Nur die Produktionsquelle ist threadsicher; alle anderen Quellen werden von genau einem Thread genutzt
+        virtual bool is_production() const { return false; }
+    };
+
+    // --- Produktion: liest die echten Uhren und CronoUtils-Quellen ---
+
+    class ProductionClock final : public ClockSource {
+    public:
+        uint64_t tsc() override;
+        uint64_t nano() override;
+        uint64_t steady() override;
+    };
+
+    class ProductionEntropy final : public EntropyProvider {
+    public:
+        void random_bytes(uint8_t* out, std::size_t length) override;
+        uint64_t ram_fingerprint() override;
+        uint64_t cache_noise() override;
+        uint64_t ghost_salt() override;
+        uint64_t memory_walk() override;
+        uint64_t binding_factor(double duration_ms) override;
+        bool is_production() const override { return true; }
+    };
+
+    ClockSource& production_clock();
+    EntropyProvider& production_entropy();
+
+    // Optionaler Hintergrund-Sammler für die Umgebungsquellen der Produktion (RAM-Fingerprint, Cache-Noise,
+    // GhostSalt, Memory Walk). Ein Thread berechnet die Werte vorab in je einen lock-freien Ring
+    // (CronoUtils::MpmcRing); ProductionEntropy entnimmt daraus und rechnet nur bei leerem Ring selbst.
+    // Feste, aufgezeichnete und wiedergegebene Quellen sind nicht betroffen; nach fork() wird inline gerechnet.
+    struct EntropyHarvesterOptions {
+        std::size_t capacity = 256;      // Pro Quelle; wird auf eine Zweierpotenz aufgerundet
+    };
+
+    struct EntropyHarvesterStats {
+        bool running = false;
+        std::size_t depth = 0;           // Aktuell vorrätige Werte über alle Quellen
+        std::size_t capacity = 0;        // Pro Quelle
+        uint64_t produced = 0;
+        uint64_t hits = 0;               // Aus dem Ring bediente Anfragen
+        uint64_t misses = 0;             // Inline berechnete Werte bei leerem Ring
+        double refill_per_second = 0.0;  // Vorab berechnete Werte pro Sekunde seit dem Start
+    };
+
+    // false, wenn bereits ein Sammler läuft
+    bool start_entropy_harvester(const EntropyHarvesterOptions& options = {});
+    void stop_entropy_harvester();
+    EntropyHarvesterStats entropy_harvester_stats();
+
+    // Von einem Hasher oder Stream genutzte Quellen; nullptr steht für die Produktionsquelle.
+    // Die Objekte gehören dem Aufrufer und müssen den Hasher/Stream überleben.
+    struct Sources {
+        ClockSource* clock = nullptr;
+        EntropyProvider* entropy = nullptr;
+    };
+
+    // --- Fest: reproduzierbare Werte für Tests und Benchmarks ---
+
+    // Liefert feste Zeitwerte; step > 0 erhöht alle drei Werte nach jedem Lesen
+    class FixedClock final : public ClockSource {
+    public:
+        explicit FixedClock(uint64_t tsc = 0, uint64_t nano = 0, uint64_t steady = 0, uint64_t step = 0);
+        uint64_t tsc() override;
+        uint64_t nano() override;
+        uint64_t steady() override;
+
+    private:
+        uint64_t tsc_, nano_, steady_, step_;
+    };
+
+    // Deterministischer Strom aus einem Seed (SplitMix64). binding_factor() wartet nicht,
+    // sodass Benchmarks die reinen Rechenkosten der Pipeline messen.
+    class FixedSeedEntropy final : public EntropyProvider {
+    public:
+        explicit FixedSeedEntropy(uint64_t seed);
+        void random_bytes(uint8_t* out, std::size_t length) override;
+        uint64_t ram_fingerprint() override { return next(); }
+        uint64_t cache_noise() override { return next(); }
+        uint64_t ghost_salt() override { return next(); }
+        uint64_t memory_walk() override { return next(); }
+        uint64_t binding_factor(double) override { return next(); }
+
+    private:
+        uint64_t next();
+        uint64_t state_;
+    };
+
+    // --- Aufzeichnen und Wiedergeben ---
+
+    // Mitschnitt aller Werte, die eine Pipeline gelesen hat (Zeit- und Entropiewerte in Aufrufreihenfolge,
+    // Zufallsbytes separat). Ein Mitschnitt aus der Produktion lässt sich als Text sichern und später wiedergeben.
+    class Recording {
+    public:
+        void push(uint64_t value);
+        void push_bytes(const uint8_t* data, std::size_t length);
+
+        // Wiedergabe; ist der Mitschnitt erschöpft, werden Nullen geliefert und exhausted() wird true
+        uint64_t next();
+        void next_bytes(uint8_t* out, std::size_t length);
+        void rewind();
+        bool exhausted() const { return exhausted_; }
+
+        std::size_t value_count() const { return values_.size(); }
+        std::size_t byte_count() const { return bytes_.size(); }
+
+        std::string to_text() const;
+        // Liefert false bei ungültigem Format (der Mitschnitt bleibt dann unverändert)
+        bool from_text(std::string_view text);
+
+    private:
+        std::vector<uint64_t> values_;
+        std::vector<uint8_t> bytes_;
+        std::size_t value_pos_ = 0;
+        std::size_t byte_pos_ = 0;
+        bool exhausted_ = false;
+    };
+
+    class RecordingClock final : public ClockSource {
+    public:
+        RecordingClock(ClockSource& inner, Recording& recording) : inner_(inner), recording_(recording) {}
+        uint64_t tsc() override;
+        uint64_t nano() override;
+        uint64_t steady() override;
+
+    private:
+        ClockSource& inner_;
+        Recording& recording_;
+    };
+
+    class RecordingEntropy final : public EntropyProvider {
+    public:
+        RecordingEntropy(EntropyProvider& inner, Recording& recording) : inner_(inner), recording_(recording) {}
+        void random_bytes(uint8_t* out, std::size_t length) override;
+        uint64_t ram_fingerprint() override;
+        uint64_t cache_noise() override;
+        uint64_t ghost_salt() override;
+        uint64_t memory_walk() override;
+        uint64_t binding_factor(double duration_ms) override;
+
+    private:
+        EntropyProvider& inner_;
+        Recording& recording_;
+    };
+
+    class ReplayClock final : public ClockSource {
+    public:
+        explicit ReplayClock(Recording& recording) : recording_(recording) {}
+        uint64_t tsc() override { return recording_.next(); }
+        uint64_t nano() override { return recording_.next(); }
+        uint64_t steady() override { return recording_.next(); }
+
+    private:
+        Recording& recording_;
+    };
+
+    class ReplayEntropy final : public EntropyProvider {
+    public:
+        explicit ReplayEntropy(Recording& recording) : recording_(recording) {}
+        void random_bytes(uint8_t* out, std::size_t length) override { recording_.next_bytes(out, length); }
+        uint64_t ram_fingerprint() override { return recording_.next(); }
+        uint64_t cache_noise() override { return recording_.next(); }
+        uint64_t ghost_salt() override { return recording_.next(); }
+        uint64_t memory_walk() override { return recording_.next(); }
+        uint64_t binding_factor(double) override { return recording_.next(); }
+
+    private:
+        Recording& recording_;
+    };
+
+    // Leitet OQS_randombytes im aktuellen Thread für die Lebensdauer des Objekts an provider um
+    // (Kyber-Public-Key und die interne Zufälligkeit von OQS_KEM_encaps). Für die Produktionsquelle ein No-op.
+    // Der Umleiter ist ab dem Laden der Bibliothek prozessweit bei liboqs registriert; Threads ohne aktive
+    // Umleitung lesen aus ihrem ChaCha20-DRBG (crono_drbg.h).
+    class ScopedRandomSource {
+    public:
+        explicit ScopedRandomSource(EntropyProvider& provider);
+        ~ScopedRandomSource();
+        ScopedRandomSource(const ScopedRandomSource&) = delete;
+        ScopedRandomSource& operator=(const ScopedRandomSource&) = delete;
+
+    private:
+        EntropyProvider* previous_ = nullptr;
+        bool active_ = false;
+    };
+
+    // Ändert sich bei jedem Aktivieren und Beenden einer Umleitung im aktuellen Thread; Zwischenspeicher für
+    // Zufallsmaterial (z. B. der Kyber-Public-Key) erkennen daran, dass sie neu ziehen müssen
+    uint64_t random_source_epoch();
+    // true, solange im aktuellen Thread eine Umleitung aktiv ist
+    bool random_source_active();
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "crono_hash.h"
+#include <cstdint>
+#include <cstdio>
+
+namespace CronoHash {
+
+    // Messwerte eines Datei-Durchlaufs. Ist wait_ms klein gegenüber hash_ms, begrenzt der Hash die
+    // Geschwindigkeit; überwiegt wait_ms, begrenzt die Eingabe. Beim Mappen fallen die Lesezugriffe als
+    // Seitenfehler in hash_ms an, dort zeigt major_faults, wie oft auf das Laufwerk gewartet wurde.
+    struct FileHashStats {
+        uint64_t bytes = 0;
+        double total_ms = 0.0;
+        double hash_ms = 0.0;         // Zeit in Stream::update()
+        double wait_ms = 0.0;         // Zeit, in der der Hash-Thread auf den nächsten Puffer wartete (nur Lesepfad)
+        uint64_t major_faults = 0;    // Seitenfehler mit Laufwerkszugriff (getrusage; unter Windows 0)
+        bool mapped = false;
+
+        double megabytes_per_second() const { return total_ms > 0.0 ? bytes / (total_ms * 1000.0) : 0.0; }
+    };
+
+    // Absorbiert den Inhalt von path ("-" = stdin) in stream, ohne ihn zu kopieren. Reguläre Dateien werden
+    // gemappt (mmap mit MADV_SEQUENTIAL bzw. MapViewOfFile mit FILE_FLAG_SEQUENTIAL_SCAN); Pipes, Geräte
+    // und Dateien, die sich nicht mappen lassen, laufen über absorb_file_stream().
+    // Bei stdin zählt nur der Rest ab der aktuellen Dateiposition, wie beim Lesen.
+    // false, wenn path nicht geöffnet oder nicht vollständig gelesen werden kann; stream enthält dann
+    // bereits einen Teil der Eingabe und sollte zurückgesetzt werden.
+    bool absorb_file(Stream& stream, const char* path, FileHashStats* stats = nullptr);
+
+    // Doppelt gepuffertes Lesen: ein eigener Thread füllt den einen Puffer, während der aufrufende Thread
+    // den anderen hasht. file bleibt geöffnet.
+    bool absorb_file_stream(Stream& stream, std::FILE* file, FileHashStats* stats = nullptr);
+}
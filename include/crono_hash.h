@@ -1,6 +1,17 @@
 #pragma once
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "crono_digest.h"
+#include "crono_encoding.h"
+#include "crono_entropy.h"
 
 namespace CronoHash {
 
@@ -12,11 +23,186 @@ namespace CronoHash {
         ENTROPIC
     };
 
+    // Version der Hash-Konstruktion; wird im HashResult und in der JSON-Ausgabe mitgeführt,
+    // damit Tokens unterschiedlicher Konstruktionen unterscheidbar bleiben.
+    // V1: jede Runde liest die vollständige Eingabe erneut (O(Worte × Länge)).
+    // V2: die Eingabe wird einmal in einen SHAKE128-Sponge absorbiert, alle Worte werden daraus abgeleitet (O(Länge + Worte)).
+    // V3: wie V2, die Quantum-Runden klonen jedoch den absorbierten Zustand und hängen nur das Wort an
+    //     (Eingabe || Tag || Wort statt Wort || Auszug); sie sehen damit die vollständige Eingabe.
+    // Regel: Ausgaben ohne Versionsangabe (Hex-String, rohe Bytes, CronoDigest) entstehen mit V1, solange der
+    // Aufrufer keine Version wählt – über den Hasher-Konstruktor oder mit Stream, der stets V3 nutzt.
+    // Nur Ausgaben, die die Version mitführen (HashResult, JSON), verwenden ohne Angabe V3.
+    enum class CronoVersion {
+        V1 = 1,
+        V2 = 2,
+        V3 = 3
+    };
+
     // Liefert den 256-Bit Hash als hexadezimale Zeichenkette (64 Zeichen).
     // binding_duration_ms definiert die Temp-Binding-Dauer in Millisekunden.
     // mode steuert zusätzliche Mix-Runden und Extra-Entropie.
-    // Neuer Parameter "bit_strength" (in Bit), z. B. 128, 256, 512, 1024, 2048.
+    // Neuer Parameter "bit_strength" (in Bit), z. B. 128, 256, 512, 1024, 2048.
+    // Nutzt CronoVersion::V1 (siehe CronoVersion): bestehende Tokens bleiben so vergleichbar. Neuere
+    // Konstruktionen über einen Hasher mit gewählter Version oder hash_with_result(), dessen Ergebnis sie trägt.
     std::string hash(const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
 
+    // Anzahl der Digest-Bytes für eine Bitstärke (Vielfaches von 8 Byte, mindestens ein Wort).
+    std::size_t digest_size(unsigned int bit_strength);
+
+    // Erzwingt für alle Bitstärken die Pipeline mit Wortanzahl zur Laufzeit statt der spezialisierten
+    // Varianten aus der Dispatch-Tabelle (z. B. für Tests; das Ergebnis ist identisch)
+    void force_runtime_pipeline(bool enabled);
+
+    // Schreibt den rohen Digest (digest_size(bit_strength) Bytes) nach out.
+    // Liefert die Anzahl geschriebener Bytes oder 0, falls out zu klein ist. Wie hash() mit CronoVersion::V1.
+    std::size_t hash_into(std::span<std::byte> out, const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+
+    // Liefert den Digest als Werttyp fester Größe; die Hex-Formatierung ist optional (CronoDigest::to_hex).
+    // digest<256>(x).to_hex() entspricht damit der Konstruktion von hash(x) (CronoVersion::V1).
+    template <unsigned Bits>
+    CronoDigest<Bits> digest(const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED) {
+        CronoDigest<Bits> d;
+        hash_into(d.bytes, data, length, binding_duration_ms, mode, Bits);
+        return d;
+    }
+
+    // Ergebnis eines einzelnen Pipeline-Durchlaufs: der Digest und exakt die Zeit- und Bindungswerte,
+    // die in ihn eingeflossen sind (binding_factor ist 0, wenn keine Zeitbindung angefordert wurde).
+    struct HashResult {
+        std::vector<std::byte> digest;
+        std::uint64_t tsc = 0;
+        std::uint64_t nano = 0;
+        std::uint64_t steady = 0;
+        std::uint64_t binding_factor = 0;
+        CronoMode mode = CronoMode::BALANCED;
+        unsigned int bit_strength = 256;
+        CronoVersion version = CronoVersion::V3;
+
+        std::string hex() const;
+        std::string encoded(Encoding encoding) const;   // hex, base64url oder Crockford-Base32 (crono_encoding.h)
+    };
+
+    HashResult hash_with_result(const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+
+    // Führt hash_with_result() auf dem persistenten Worker-Pool aus (CronoUtils::WorkerPool::shared()), sodass der
+    // aufrufende Thread nicht für die Dauer der Zeitbindung wartet. data wird übernommen.
+    std::future<HashResult> hash_async(std::string data, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+    // Variante mit Callback; done läuft auf einem Worker-Thread
+    void hash_async(std::string data, std::function<void(HashResult)> done, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+
+    // Optionale JSON-Serialisierung eines HashResult
+    std::string to_json(const HashResult& result);
+    // Wie oben, der String wird jedoch aus resource allokiert (z. B. CronoUtils::scratch_resource())
+    std::pmr::string to_json(const HashResult& result, std::pmr::memory_resource* resource);
+    // Hängt das Ergebnis als einzeiliges JSON-Objekt mit abschließendem '\n' an out an (JSON Lines);
+    // der Hash steht in encoding, bei allem außer Hex ergänzt um das Feld "encoding"
+    void append_json_line(std::string& out, const HashResult& result, Encoding encoding = Encoding::Hex);
+
+    // Optionen für hash_batch
+    struct BatchOptions {
+        double binding_duration_ms = 0.0;
+        CronoMode mode = CronoMode::BALANCED;
+        unsigned int bit_strength = 256;
+        unsigned int num_threads = 0;   // 0 = std::thread::hardware_concurrency()
+    };
+
+    // Hasht alle inputs mit gemeinsamer Umgebungsentropie und einmaliger Zeitbindung; jeder Worker-Thread
+    // kapselt über seine eigene CronoQuantum::KyberSession (KyberSession::for_this_thread()), deren
+    // Schlüsselpaar über Batches hinweg bestehen bleibt. Digest i landet in out[i * digest_size, (i + 1) * digest_size).
+    // Liefert die Anzahl geschriebener Digests oder 0, falls out zu klein ist. Wie hash() mit CronoVersion::V1;
+    // andere Versionen über Hasher::hash_batch().
+    std::size_t hash_batch(std::span<const std::string_view> inputs, std::span<std::byte> out, const BatchOptions& options = {});
+
+    // to_json() eines V1-Ergebnisses; Legacy-Gegenstück zu hash()
     std::string hash_with_metadata(const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+
+    // Wann ein Hasher seine Umgebungsentropie (RAM-Fingerprint, Cache-Noise, GhostSalt) neu erhebt.
+    // Ein Wert von 0 deaktiviert die jeweilige Bedingung; ohne aktive Bedingung bleibt die
+    // Entropie bis zu einem expliziten refresh() bestehen.
+    struct RefreshPolicy {
+        std::uint64_t every_n_hashes = 0;   // Nach N Hashes neu erheben
+        std::uint64_t every_us = 0;         // Nach T Mikrosekunden (Steady Clock) neu erheben
+        bool on_fork = true;                // Im Kindprozess nach fork() neu erheben
+    };
+
+    // Zustandsbehafteter Hash-Kontext: Die teuren Umgebungsquellen werden einmal erhoben und
+    // gemäß RefreshPolicy erneuert, sodass wiederholte hash()-Aufrufe nur die Mix-Runden bezahlen.
+    // Ein Hasher ist nicht threadsicher – pro Thread eine eigene Instanz verwenden.
+    // Über sources lassen sich Uhren und Entropiequellen ersetzen (feste Werte für Tests und Benchmarks,
+    // Aufzeichnen/Wiedergeben eines Produktionsfalls); ohne Angabe werden die Produktionsquellen genutzt.
+    // Zwischenpuffer der Pipeline stammen aus scratch oder, ohne Angabe, aus der Scratch-Arena des
+    // aufrufenden Threads (crono_arena.h); nach dem ersten Aufruf allokiert hash_into() nichts mehr.
+    // Eine eigene Ressource muss threadsicher sein, wenn hash_batch() mehrere Threads nutzt.
+    // Ohne Angabe von version gilt V1 wie für alle Ausgaben ohne Versionsangabe (siehe CronoVersion);
+    // V2/V3 müssen ausdrücklich gewählt werden.
+    class Hasher {
+    public:
+        explicit Hasher(RefreshPolicy policy = {}, CronoVersion version = CronoVersion::V1, CronoEntropy::Sources sources = {}, std::pmr::memory_resource* scratch = nullptr);
+
+        std::string hash(const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+        std::size_t hash_into(std::span<std::byte> out, const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+        HashResult hash_with_result(const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256);
+        std::size_t hash_batch(std::span<const std::string_view> inputs, std::span<std::byte> out, const BatchOptions& options = {});
+
+        template <unsigned Bits>
+        CronoDigest<Bits> digest(const char* data, std::size_t length, double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED) {
+            CronoDigest<Bits> d;
+            hash_into(d.bytes, data, length, binding_duration_ms, mode, Bits);
+            return d;
+        }
+
+        // Erhebt die Umgebungsentropie sofort neu.
+        void refresh();
+
+        const RefreshPolicy& policy() const { return policy_; }
+        CronoVersion version() const { return version_; }
+        std::pmr::memory_resource* scratch() const { return scratch_; }
+        std::uint64_t hashes_since_refresh() const { return hashes_since_refresh_; }
+
+    private:
+        void refresh_if_due();
+
+        RefreshPolicy policy_;
+        CronoVersion version_;
+        CronoEntropy::ClockSource* clock_;
+        CronoEntropy::EntropyProvider* entropy_;
+        std::pmr::memory_resource* scratch_;
+        std::uint64_t ram_ = 0;
+        std::uint64_t cache_ = 0;
+        std::uint64_t ghost_ = 0;
+        std::uint64_t hashes_since_refresh_ = 0;
+        std::uint64_t refreshed_at_ns_ = 0;
+        long pid_ = 0;
+    };
+
+    // Inkrementelles Hashen großer Eingaben (Dateien, Sockets) mit konstantem Speicherbedarf.
+    // update() absorbiert jedes Byte genau einmal in einen SHAKE128-Sponge; final() leitet daraus alle
+    // Worte nach der V3-Konstruktion ab (dieselbe Konstruktion wie Hasher mit CronoVersion::V3).
+    // Nach final() ist der Stream zurückgesetzt und kann erneut verwendet werden.
+    // scratch: Ressource für die Zwischenpuffer von final() (wie bei Hasher).
+    class Stream {
+    public:
+        explicit Stream(double binding_duration_ms = 0.0, CronoMode mode = CronoMode::BALANCED, unsigned int bit_strength = 256, CronoEntropy::Sources sources = {}, std::pmr::memory_resource* scratch = nullptr);
+        ~Stream();
+        Stream(Stream&&) noexcept;
+        Stream& operator=(Stream&&) noexcept;
+        Stream(const Stream&) = delete;
+        Stream& operator=(const Stream&) = delete;
+
+        void update(std::span<const std::byte> chunk);
+        void update(const char* data, std::size_t length);
+
+        // Schreibt den Digest nach out; liefert die Anzahl geschriebener Bytes oder 0, falls out zu klein ist
+        // (der Stream bleibt dann unverändert). Allokiert nach dem ersten Aufruf nichts mehr.
+        std::size_t final_into(std::span<std::byte> out);
+        // final_into() plus Zeit- und Bindungswerte im HashResult
+        HashResult final();
+
+        void reset();
+        std::uint64_t bytes_absorbed() const;
+
+    private:
+        struct State;
+        std::unique_ptr<State> state_;
+    };
 }
@@ -1,10 +1,46 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 namespace CronoMath {
     // SHA256-ähnliche Primzahlen (für die erste Rundendurchläufe)
     extern const uint64_t* PRIMES;
     extern const int NUM_PRIMES;
+    // Zusätzliche Primzahlen für mod_prime256 (Index modulo NUM_EXTRA_PRIMES)
+    extern const uint64_t* EXTRA_PRIMES;
+    extern const int NUM_EXTRA_PRIMES;
+
+    // Vorberechneter Kehrwert für die divisionsfreie Reduktion x % divisor.
+    // magic = floor((2^64 - 1) / divisor) liefert über das obere Produktwort einen Quotienten,
+    // der höchstens um 1 zu klein ist; eine bedingte Subtraktion korrigiert den Rest.
+    struct Reciprocal {
+        uint64_t divisor = 1;
+        uint64_t magic = ~0ULL;
+    };
+
+    constexpr Reciprocal make_reciprocal(uint64_t divisor) {
+        if (divisor == 0)
+            divisor = 1; // Damit nicht durch 0 geteilt wird
+        return { divisor, ~0ULL / divisor };
+    }
+
+    inline uint64_t mulhi64(uint64_t a, uint64_t b) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return __umulh(a, b);
+#else
+        __extension__ typedef unsigned __int128 uint128_t;
+        return static_cast<uint64_t>((static_cast<uint128_t>(a) * b) >> 64);
+#endif
+    }
+
+    // Bitgenau identisch mit x % r.divisor
+    inline uint64_t reduce(uint64_t x, const Reciprocal& r) {
+        uint64_t rem = x - mulhi64(x, r.magic) * r.divisor;
+        return rem >= r.divisor ? rem - r.divisor : rem;
+    }
 
     // Wendet zuerst den Modulo mit einer Basis-Primzahl an
     uint64_t mod_prime(uint64_t input);
@@ -15,4 +51,21 @@ namespace CronoMath {
     uint64_t endomorph_transform(uint64_t input, uint64_t seed);
     // Mischt das Input mit konstanten Werten, um eine One-Way-Funktion zu erzeugen
     uint64_t hash_const_mix(uint64_t input);
+
+    // Vektorisierte Varianten für unabhängige Wort-Arrays. Die Ergebnisse sind bitgenau identisch mit
+    // den skalaren Funktionen; die Variante (AVX-512, AVX2, skalar) wird beim Start per CPUID gewählt.
+    enum class SimdLevel {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+    SimdLevel simd_level();
+    // Erzwingt eine Variante (z. B. für Tests); false, wenn die CPU sie nicht unterstützt.
+    // Darf parallel zu laufenden Berechnungen aufgerufen werden.
+    bool force_simd_level(SimdLevel level);
+
+    void endomorph_transform_words(uint64_t* words, std::size_t n, uint64_t seed);
+    void hash_const_mix_words(uint64_t* words, std::size_t n);
+    // words[i] = mod_prime256(words[i], i % 4) – dieselbe Indexfolge wie in der Hash-Pipeline
+    void mod_prime256_words(uint64_t* words, std::size_t n);
 }
@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CronoUtils {
+
+    // Persistenter Thread-Pool für Zeitbindung, hash_batch und hash_async. Die Worker werden einmal gestartet
+    // und warten zwischen den Aufträgen an einer Condition Variable, statt pro Aufruf neu erzeugt zu werden.
+    class WorkerPool {
+    public:
+        explicit WorkerPool(unsigned int threads = 0);   // 0 = std::thread::hardware_concurrency()
+        ~WorkerPool();
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Reiht task ein; im Kindprozess nach fork() laufen keine Worker, dort wird task sofort ausgeführt
+        void submit(std::function<void()> task);
+
+        // Führt fn(i) für alle i in [0, n) aus, verteilt auf bis zu n - 1 Worker und den aufrufenden Thread,
+        // und kehrt erst zurück, wenn alle Aufrufe beendet sind. Der Aufrufer übernimmt jeden Index, den noch
+        // kein Worker begonnen hat; ein ausgelasteter Pool verzögert daher, blockiert aber nie.
+        void parallel_for(std::size_t n, const std::function<void(std::size_t)>& fn);
+
+        unsigned int size() const { return static_cast<unsigned int>(threads_.size()); }
+        uint64_t tasks_completed() const { return completed_.load(std::memory_order_relaxed); }
+
+        // Prozessweiter Pool mit hardware_concurrency() Workern, beim ersten Gebrauch gestartet
+        static WorkerPool& shared();
+
+    private:
+        void run();
+
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<std::function<void()>> tasks_;
+        std::vector<std::thread> threads_;
+        bool stopping_ = false;
+        const long pid_;
+        std::atomic<uint64_t> completed_{ 0 };
+    };
+}
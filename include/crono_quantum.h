@@ -1,10 +1,136 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <vector>
+
+struct OQS_KEM;  // liboqs, siehe <oqs/kem.h>
 
 namespace CronoQuantum {
+
+    // Wiederverwendbarer Kyber512-Kontext: KEM-Objekt, Puffer und ein Schlüsselpaar, das alle
+    // rotate_every Kapselungen aus 64 frischen Zufallsbytes neu erzeugt wird (OQS_KEM_kyber_512_keypair_derand).
+    // Ein Schlüsselwechsel erfolgt außerdem, sobald sich die Zufallsquelle des Threads ändert
+    // (CronoEntropy::random_source_epoch), damit feste und wiedergegebene Entropiequellen reproduzierbar bleiben.
+    // Nicht threadsicher.
+    class KyberSession {
+    public:
+        static constexpr uint64_t DEFAULT_ROTATION = 64;
+        static constexpr std::size_t COIN_BYTES = 32;  // Zufallsbytes einer deterministischen Kapselung
+
+        explicit KyberSession(uint64_t rotate_every = DEFAULT_ROTATION);
+        ~KyberSession();
+        KyberSession(const KyberSession&) = delete;
+        KyberSession& operator=(const KyberSession&) = delete;
+
+        // Kapselt gegen den aktuellen Public Key; liefert nullptr, wenn Kyber512 nicht verfügbar ist
+        // oder die Kapselung fehlschlägt. Der Zeiger bleibt bis zum nächsten Aufruf gültig.
+        const uint8_t* encapsulate();
+        // Deterministische Kapselung mit COIN_BYTES vom Aufrufer gelieferten Zufallsbytes; zieht außer beim
+        // Schlüsselwechsel keine Systementropie. Die Matrix A des Public Keys wird nur beim Schlüsselwechsel
+        // expandiert (OQS_KEM_kyber_512_expand_public_key), jede Kapselung überspringt gen_matrix.
+        const uint8_t* encapsulate(const uint8_t* coins);
+        std::size_t shared_secret_length() const { return shared_secret_.size(); }
+
+        uint64_t encapsulations() const { return encapsulations_; }
+        uint64_t rotations() const { return rotations_; }
+
+        // Sitzung des aufrufenden Threads
+        static KyberSession& for_this_thread();
+
+    private:
+        void rotate();
+
+        OQS_KEM* kem_ = nullptr;
+        std::vector<uint8_t> public_key_;
+        std::vector<uint8_t> secret_key_;
+        struct ExpandedKey;
+        std::unique_ptr<ExpandedKey> expanded_key_;
+        std::vector<uint8_t> ciphertext_;
+        std::vector<uint8_t> shared_secret_;
+        uint64_t rotate_every_;
+        uint64_t uses_since_rotation_ = 0;
+        uint64_t encapsulations_ = 0;
+        uint64_t rotations_ = 0;
+        uint64_t epoch_ = 0;
+        bool keyed_ = false;
+    };
+
+    // Optionaler Hintergrund-Pool vorab berechneter Kyber-Kapselungen. Das Shared Secret hängt nicht von der
+    // Eingabe ab; Produzenten-Threads füllen daher einen begrenzten, lock-freien Ring, aus dem
+    // quantum_mix_kyber() bedient wird, und OQS_KEM_encaps verlässt den Anfragepfad.
+    // Ist eine Test-/Replay-Zufallsquelle aktiv (CronoEntropy::ScopedRandomSource), wird der Pool umgangen.
+    enum class PoolExhaustion {
+        Inline,  // Leerer Pool: im aufrufenden Thread kapseln (zählt als Fallback)
+        Block    // Leerer Pool: auf den nächsten Eintrag warten
+    };
+
+    struct EncapsulationPoolOptions {
+        std::size_t capacity = 1024;     // Wird auf eine Zweierpotenz aufgerundet
+        unsigned int producers = 1;
+        PoolExhaustion when_empty = PoolExhaustion::Inline;
+        uint64_t rotate_every = KyberSession::DEFAULT_ROTATION;
+    };
+
+    struct EncapsulationPoolStats {
+        bool running = false;
+        std::size_t depth = 0;           // Aktuell vorrätige Shared Secrets
+        std::size_t capacity = 0;
+        uint64_t produced = 0;
+        uint64_t consumed = 0;
+        uint64_t fallbacks = 0;          // Inline berechnete Kapselungen bei leerem Pool
+        uint64_t waits = 0;              // Blockierende Entnahmen bei leerem Pool
+    };
+
+    // false, wenn bereits ein Pool läuft oder Kyber512 nicht verfügbar ist
+    bool start_encapsulation_pool(const EncapsulationPoolOptions& options = {});
+    void stop_encapsulation_pool();
+    EncapsulationPoolStats encapsulation_pool_stats();
+
     // Bestehende Funktion
     uint64_t quantum_mix(uint64_t input, const char* data, std::size_t length);
-    // Neue Funktion: Kyber512-Phase
+    // words[i] ^= quantum_mix(words[i], data, length) für alle Worte; je vier Worte laufen gemeinsam durch
+    // OQS_SHA3_shake128_x4 (AVX2-Keccak-x4, sofern liboqs damit gebaut wurde), der Rest skalar
+    void quantum_mix_words(uint64_t* words, std::size_t n, const char* data, std::size_t length);
+    // Neue Funktion: Kyber512-Phase (nutzt den Pool, falls gestartet, sonst die KyberSession des aufrufenden Threads).
+    // Ohne Pool stammen die Kapselungs-Coins aus der zweiten Hälfte des 64-Byte-SHAKE-Seeds.
     uint64_t quantum_mix_kyber(uint64_t input, const char* data, std::size_t length);
+    uint64_t quantum_mix_kyber(uint64_t input, const char* data, std::size_t length, KyberSession& session);
+
+    // V3: Die Eingabe wird einmal in einen SHAKE128-Zustand absorbiert. Jede Ableitung klont diesen Zustand
+    // (OQS_SHA3_shake128_inc_ctx_clone) und absorbiert nur ihr eigenes kurzes Suffix, sodass die Kosten pro
+    // Wort nicht mehr von der Eingabelänge abhängen. Nicht threadsicher.
+    // Ein verschobenes Objekt verhält sich wie ein frisch konstruiertes (leere Eingabe).
+    class AbsorbedInput {
+    public:
+        AbsorbedInput();
+        ~AbsorbedInput();
+        AbsorbedInput(AbsorbedInput&&) noexcept;
+        AbsorbedInput& operator=(AbsorbedInput&&) noexcept;
+        AbsorbedInput(const AbsorbedInput&) = delete;
+        AbsorbedInput& operator=(const AbsorbedInput&) = delete;
+
+        void absorb(const void* data, std::size_t length);
+        void reset();
+        uint64_t absorbed() const { return absorbed_; }
+
+        // out = SHAKE128(Eingabe || suffix), out_length Bytes; der absorbierte Zustand bleibt unverändert
+        void derive(const uint8_t* suffix, std::size_t suffix_length, uint8_t* out, std::size_t out_length) const;
+
+    private:
+        struct Contexts;
+        // Legt nach einem Move einen frischen Zustand an
+        Contexts& contexts() const;
+
+        mutable std::unique_ptr<Contexts> ctx_;
+        uint64_t absorbed_ = 0;
+    };
+
+    // Domänen-Tags der V3-Ableitungen (Eingabe || Tag || Wort)
+    constexpr uint8_t QUANTUM_MIX_TAG = 0x51;    // 'Q'
+    constexpr uint8_t QUANTUM_KYBER_TAG = 0x4B;  // 'K'
+
+    // V3-Gegenstücke der Quantum-Runden: words[i] ^= f(SHAKE128(Eingabe || Tag || words[i]))
+    void quantum_mix_words(uint64_t* words, std::size_t n, const AbsorbedInput& input);
+    void quantum_mix_kyber_words(uint64_t* words, std::size_t n, const AbsorbedInput& input);
 }
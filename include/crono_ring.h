@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace CronoUtils {
+
+    // Begrenzte, lock-freie MPMC-Queue (Ringpuffer nach D. Vyukov). Jede Zelle trägt eine Sequenznummer,
+    // über die Produzenten und Konsumenten ohne Locks erkennen, ob die Zelle frei bzw. gefüllt ist.
+    // Die Kapazität wird auf die nächste Zweierpotenz aufgerundet.
+    template <typename T>
+    class MpmcRing {
+    public:
+        explicit MpmcRing(std::size_t capacity)
+            : mask_(round_up_pow2(capacity < 2 ? 2 : capacity) - 1), cells_(std::make_unique<Cell[]>(mask_ + 1)) {
+            for (std::size_t i = 0; i <= mask_; i++) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpmcRing(const MpmcRing&) = delete;
+        MpmcRing& operator=(const MpmcRing&) = delete;
+
+        // false, wenn der Ring voll ist
+        bool try_push(const T& value) {
+            Cell* cell;
+            std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) {
+                    return false;
+                }
+                else {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = value;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // false, wenn der Ring leer ist
+        bool try_pop(T& out) {
+            Cell* cell;
+            std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) {
+                    return false;
+                }
+                else {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            out = cell->value;
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Momentaufnahme des Füllstands (bei gleichzeitigen Zugriffen nur näherungsweise)
+        std::size_t size_approx() const {
+            const std::size_t enq = enqueue_pos_.load(std::memory_order_relaxed);
+            const std::size_t deq = dequeue_pos_.load(std::memory_order_relaxed);
+            return enq > deq ? enq - deq : 0;
+        }
+
+        std::size_t capacity() const { return mask_ + 1; }
+
+    private:
+        static std::size_t round_up_pow2(std::size_t n) {
+            std::size_t p = 1;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+
+        struct Cell {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        // Eigene Cache-Lines für Schreib- und Lese-Position, damit Produzenten und Konsumenten sich nicht stören
+        static constexpr std::size_t CACHE_LINE = 64;
+
+        const std::size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+        alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_pos_{ 0 };
+        alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_pos_{ 0 };
+    };
+}
@@ -16,14 +16,33 @@ namespace CronoUtils {
     uint64_t memory_walk();
     uint64_t adaptive_binding_factor(double duration_ms);
     uint64_t ghost_salt();
+    // Prozess-ID; wechselt im Kindprozess nach fork()
+    long current_pid();
 
+    // Hardware-Fingerprinting; jeder Aufruf fragt das System direkt ab
+    uint64_t get_cpu_id();        // Hersteller, Signatur und Modellname per CPUID
+    uint64_t os_boot_time();      // Startzeitpunkt des Systems in ns
+    uint64_t bios_serial();
 #ifdef _WIN32
-    // Produktionsreife Hardware-Fingerprinting-Funktionen (Windows-spezifisch)
-    uint64_t get_cpu_id();
     uint64_t tpm_fingerprint();
-    uint64_t os_boot_time();
-    uint64_t bios_serial();
-    std::string generate_system_chain_id();
 #endif
 
+    // Momentaufnahme der Hardware-Merkmale. Wird beim ersten Gebrauch einmal erhoben und danach nur neu
+    // berechnet, wenn sich die Boot-ID ndert (Linux, hchstens einmal pro Sekunde geprft) oder
+    // refresh_system_fingerprint() aufgerufen wird.
+    struct SystemFingerprint {
+        uint64_t cpu_id = 0;
+        uint64_t tpm = 0;          // Nur unter Windows belegt
+        uint64_t boot_time = 0;
+        uint64_t bios = 0;
+        uint64_t boot_id = 0;      // Hash von /proc/sys/kernel/random/boot_id; unter Windows 0
+        uint64_t generation = 0;   // Zhlt die Erhebungen, beginnend bei 1
+    };
+
+    SystemFingerprint system_fingerprint();
+    void refresh_system_fingerprint();
+
+    // Verkettet die Momentaufnahme mit frischem RAM-Fingerprint und TSC
+    std::string generate_system_chain_id();
+
 } // namespace CronoUtils
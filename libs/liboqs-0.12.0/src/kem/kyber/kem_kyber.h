@@ -10,10 +10,21 @@
 #define OQS_KEM_kyber_512_length_secret_key 1632
 #define OQS_KEM_kyber_512_length_ciphertext 768
 #define OQS_KEM_kyber_512_length_shared_secret 32
+#define OQS_KEM_kyber_512_length_keypair_seed 64
+#define OQS_KEM_kyber_512_length_encaps_seed 32
+#define OQS_KEM_kyber_512_length_expanded_public_key 3104
 OQS_KEM *OQS_KEM_kyber_512_new(void);
 OQS_API OQS_STATUS OQS_KEM_kyber_512_keypair(uint8_t *public_key, uint8_t *secret_key);
 OQS_API OQS_STATUS OQS_KEM_kyber_512_encaps(uint8_t *ciphertext, uint8_t *shared_secret, const uint8_t *public_key);
 OQS_API OQS_STATUS OQS_KEM_kyber_512_decaps(uint8_t *shared_secret, const uint8_t *ciphertext, const uint8_t *secret_key);
+/* Derandomized variants: all randomness is taken from the caller-supplied seed (keypair: d || z, encaps: m) */
+OQS_API OQS_STATUS OQS_KEM_kyber_512_keypair_derand(uint8_t *public_key, uint8_t *secret_key, const uint8_t *seed);
+OQS_API OQS_STATUS OQS_KEM_kyber_512_encaps_derand(uint8_t *ciphertext, uint8_t *shared_secret, const uint8_t *public_key, const uint8_t *seed);
+/* Repeated encapsulations under one public key: expand matrix A once, then encapsulate without gen_matrix.
+ * The expanded key is an opaque, 32-byte aligned buffer of OQS_KEM_kyber_512_length_expanded_public_key bytes;
+ * it is only valid in the process (and on the CPU) that created it. */
+OQS_API OQS_STATUS OQS_KEM_kyber_512_expand_public_key(uint8_t *expanded_public_key, const uint8_t *public_key);
+OQS_API OQS_STATUS OQS_KEM_kyber_512_encaps_expanded_derand(uint8_t *ciphertext, uint8_t *shared_secret, const uint8_t *expanded_public_key, const uint8_t *seed);
 #endif
 
 #if defined(OQS_ENABLE_KEM_kyber_768)
@@ -31,12 +31,20 @@ OQS_KEM *OQS_KEM_kyber_512_new(void) {
 }
 
 extern int pqcrystals_kyber512_ref_keypair(uint8_t *pk, uint8_t *sk);
+extern int pqcrystals_kyber512_ref_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins);
 extern int pqcrystals_kyber512_ref_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk);
+extern int pqcrystals_kyber512_ref_enc_derand(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins);
+extern int pqcrystals_kyber512_ref_expand_pk(uint8_t *epk, const uint8_t *pk);
+extern int pqcrystals_kyber512_ref_enc_expanded_derand(uint8_t *ct, uint8_t *ss, const uint8_t *epk, const uint8_t *coins);
 extern int pqcrystals_kyber512_ref_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 
 #if defined(OQS_ENABLE_KEM_kyber_512_avx2)
 extern int pqcrystals_kyber512_avx2_keypair(uint8_t *pk, uint8_t *sk);
+extern int pqcrystals_kyber512_avx2_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins);
 extern int pqcrystals_kyber512_avx2_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk);
+extern int pqcrystals_kyber512_avx2_enc_derand(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins);
+extern int pqcrystals_kyber512_avx2_expand_pk(uint8_t *epk, const uint8_t *pk);
+extern int pqcrystals_kyber512_avx2_enc_expanded_derand(uint8_t *ct, uint8_t *ss, const uint8_t *epk, const uint8_t *coins);
 extern int pqcrystals_kyber512_avx2_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 #endif
 
@@ -48,12 +56,16 @@ extern int PQCLEAN_KYBER512_AARCH64_crypto_kem_dec(uint8_t *ss, const uint8_t *c
 
 #if defined(OQS_ENABLE_LIBJADE_KEM_kyber_512)
 extern int libjade_kyber512_ref_keypair(uint8_t *pk, uint8_t *sk);
+extern int jade_kem_kyber_kyber512_amd64_ref_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins);
+extern int jade_kem_kyber_kyber512_amd64_ref_enc_derand(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins);
 extern int libjade_kyber512_ref_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk);
 extern int libjade_kyber512_ref_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 #endif
 
 #if defined(OQS_ENABLE_LIBJADE_KEM_kyber_512_avx2)
 extern int libjade_kyber512_avx2_keypair(uint8_t *pk, uint8_t *sk);
+extern int jade_kem_kyber_kyber512_amd64_avx2_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins);
+extern int jade_kem_kyber_kyber512_amd64_avx2_enc_derand(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins);
 extern int libjade_kyber512_avx2_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk);
 extern int libjade_kyber512_avx2_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 #endif
@@ -143,6 +155,105 @@ OQS_API OQS_STATUS OQS_KEM_kyber_512_encaps(uint8_t *ciphertext, uint8_t *shared
 #endif /* OQS_LIBJADE_BUILD */
 }
 
+OQS_API OQS_STATUS OQS_KEM_kyber_512_keypair_derand(uint8_t *public_key, uint8_t *secret_key, const uint8_t *seed) {
+#if defined(OQS_LIBJADE_BUILD) && (defined(OQS_ENABLE_LIBJADE_KEM_kyber_512))
+#if defined(OQS_ENABLE_LIBJADE_KEM_kyber_512_avx2)
+#if defined(OQS_DIST_BUILD)
+	if (OQS_CPU_has_extension(OQS_CPU_EXT_AVX2) && OQS_CPU_has_extension(OQS_CPU_EXT_BMI2) && OQS_CPU_has_extension(OQS_CPU_EXT_POPCNT)) {
+#endif /* OQS_DIST_BUILD */
+		return (OQS_STATUS) jade_kem_kyber_kyber512_amd64_avx2_keypair_derand(public_key, secret_key, seed);
+#if defined(OQS_DIST_BUILD)
+	} else {
+		return (OQS_STATUS) jade_kem_kyber_kyber512_amd64_ref_keypair_derand(public_key, secret_key, seed);
+	}
+#endif /* OQS_DIST_BUILD */
+#else
+	return (OQS_STATUS) jade_kem_kyber_kyber512_amd64_ref_keypair_derand(public_key, secret_key, seed);
+#endif
+#else /*OQS_LIBJADE_BUILD && (OQS_ENABLE_LIBJADE_KEM_kyber_512)*/
+#if defined(OQS_ENABLE_KEM_kyber_512_avx2)
+#if defined(OQS_DIST_BUILD)
+	if (OQS_CPU_has_extension(OQS_CPU_EXT_AVX2) && OQS_CPU_has_extension(OQS_CPU_EXT_BMI2) && OQS_CPU_has_extension(OQS_CPU_EXT_POPCNT)) {
+#endif /* OQS_DIST_BUILD */
+		return (OQS_STATUS) pqcrystals_kyber512_avx2_keypair_derand(public_key, secret_key, seed);
+#if defined(OQS_DIST_BUILD)
+	} else {
+		return (OQS_STATUS) pqcrystals_kyber512_ref_keypair_derand(public_key, secret_key, seed);
+	}
+#endif /* OQS_DIST_BUILD */
+#else
+	/* The aarch64 implementation has no derandomized entry point; the reference code computes the same result */
+	return (OQS_STATUS) pqcrystals_kyber512_ref_keypair_derand(public_key, secret_key, seed);
+#endif
+#endif /* OQS_LIBJADE_BUILD */
+}
+
+OQS_API OQS_STATUS OQS_KEM_kyber_512_encaps_derand(uint8_t *ciphertext, uint8_t *shared_secret, const uint8_t *public_key, const uint8_t *seed) {
+#if defined(OQS_LIBJADE_BUILD) && (defined(OQS_ENABLE_LIBJADE_KEM_kyber_512))
+#if defined(OQS_ENABLE_LIBJADE_KEM_kyber_512_avx2)
+#if defined(OQS_DIST_BUILD)
+	if (OQS_CPU_has_extension(OQS_CPU_EXT_AVX2) && OQS_CPU_has_extension(OQS_CPU_EXT_BMI2) && OQS_CPU_has_extension(OQS_CPU_EXT_POPCNT)) {
+#endif /* OQS_DIST_BUILD */
+		return (OQS_STATUS) jade_kem_kyber_kyber512_amd64_avx2_enc_derand(ciphertext, shared_secret, public_key, seed);
+#if defined(OQS_DIST_BUILD)
+	} else {
+		return (OQS_STATUS) jade_kem_kyber_kyber512_amd64_ref_enc_derand(ciphertext, shared_secret, public_key, seed);
+	}
+#endif /* OQS_DIST_BUILD */
+#else
+	return (OQS_STATUS) jade_kem_kyber_kyber512_amd64_ref_enc_derand(ciphertext, shared_secret, public_key, seed);
+#endif
+#else /*OQS_LIBJADE_BUILD && (OQS_ENABLE_LIBJADE_KEM_kyber_512)*/
+#if defined(OQS_ENABLE_KEM_kyber_512_avx2)
+#if defined(OQS_DIST_BUILD)
+	if (OQS_CPU_has_extension(OQS_CPU_EXT_AVX2) && OQS_CPU_has_extension(OQS_CPU_EXT_BMI2) && OQS_CPU_has_extension(OQS_CPU_EXT_POPCNT)) {
+#endif /* OQS_DIST_BUILD */
+		return (OQS_STATUS) pqcrystals_kyber512_avx2_enc_derand(ciphertext, shared_secret, public_key, seed);
+#if defined(OQS_DIST_BUILD)
+	} else {
+		return (OQS_STATUS) pqcrystals_kyber512_ref_enc_derand(ciphertext, shared_secret, public_key, seed);
+	}
+#endif /* OQS_DIST_BUILD */
+#else
+	/* The aarch64 implementation has no derandomized entry point; the reference code computes the same result */
+	return (OQS_STATUS) pqcrystals_kyber512_ref_enc_derand(ciphertext, shared_secret, public_key, seed);
+#endif
+#endif /* OQS_LIBJADE_BUILD */
+}
+
+/* The expanded key layout is only defined by the pqcrystals code, also in libjade builds */
+OQS_API OQS_STATUS OQS_KEM_kyber_512_expand_public_key(uint8_t *expanded_public_key, const uint8_t *public_key) {
+#if defined(OQS_ENABLE_KEM_kyber_512_avx2)
+#if defined(OQS_DIST_BUILD)
+	if (OQS_CPU_has_extension(OQS_CPU_EXT_AVX2) && OQS_CPU_has_extension(OQS_CPU_EXT_BMI2) && OQS_CPU_has_extension(OQS_CPU_EXT_POPCNT)) {
+#endif /* OQS_DIST_BUILD */
+		return (OQS_STATUS) pqcrystals_kyber512_avx2_expand_pk(expanded_public_key, public_key);
+#if defined(OQS_DIST_BUILD)
+	} else {
+		return (OQS_STATUS) pqcrystals_kyber512_ref_expand_pk(expanded_public_key, public_key);
+	}
+#endif /* OQS_DIST_BUILD */
+#else
+	return (OQS_STATUS) pqcrystals_kyber512_ref_expand_pk(expanded_public_key, public_key);
+#endif
+}
+
+OQS_API OQS_STATUS OQS_KEM_kyber_512_encaps_expanded_derand(uint8_t *ciphertext, uint8_t *shared_secret, const uint8_t *expanded_public_key, const uint8_t *seed) {
+#if defined(OQS_ENABLE_KEM_kyber_512_avx2)
+#if defined(OQS_DIST_BUILD)
+	if (OQS_CPU_has_extension(OQS_CPU_EXT_AVX2) && OQS_CPU_has_extension(OQS_CPU_EXT_BMI2) && OQS_CPU_has_extension(OQS_CPU_EXT_POPCNT)) {
+#endif /* OQS_DIST_BUILD */
+		return (OQS_STATUS) pqcrystals_kyber512_avx2_enc_expanded_derand(ciphertext, shared_secret, expanded_public_key, seed);
+#if defined(OQS_DIST_BUILD)
+	} else {
+		return (OQS_STATUS) pqcrystals_kyber512_ref_enc_expanded_derand(ciphertext, shared_secret, expanded_public_key, seed);
+	}
+#endif /* OQS_DIST_BUILD */
+#else
+	return (OQS_STATUS) pqcrystals_kyber512_ref_enc_expanded_derand(ciphertext, shared_secret, expanded_public_key, seed);
+#endif
+}
+
 OQS_API OQS_STATUS OQS_KEM_kyber_512_decaps(uint8_t *shared_secret, const uint8_t *ciphertext, const uint8_t *secret_key) {
 #if defined(OQS_LIBJADE_BUILD) && (defined(OQS_ENABLE_LIBJADE_KEM_kyber_512))
 #if defined(OQS_ENABLE_LIBJADE_KEM_kyber_512_avx2)
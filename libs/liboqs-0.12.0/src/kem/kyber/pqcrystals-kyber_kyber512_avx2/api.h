@@ -7,14 +7,19 @@
 #define pqcrystals_kyber512_PUBLICKEYBYTES 800
 #define pqcrystals_kyber512_CIPHERTEXTBYTES 768
 #define pqcrystals_kyber512_BYTES 32
+#define pqcrystals_kyber512_EXPANDEDPUBLICKEYBYTES 3104
 
 #define pqcrystals_kyber512_avx2_SECRETKEYBYTES pqcrystals_kyber512_SECRETKEYBYTES
 #define pqcrystals_kyber512_avx2_PUBLICKEYBYTES pqcrystals_kyber512_PUBLICKEYBYTES
 #define pqcrystals_kyber512_avx2_CIPHERTEXTBYTES pqcrystals_kyber512_CIPHERTEXTBYTES
 #define pqcrystals_kyber512_avx2_BYTES pqcrystals_kyber512_BYTES
 
+int pqcrystals_kyber512_avx2_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins);
 int pqcrystals_kyber512_avx2_keypair(uint8_t *pk, uint8_t *sk);
+int pqcrystals_kyber512_avx2_enc_derand(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins);
 int pqcrystals_kyber512_avx2_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk);
+int pqcrystals_kyber512_avx2_expand_pk(uint8_t *epk, const uint8_t *pk);
+int pqcrystals_kyber512_avx2_enc_expanded_derand(uint8_t *ct, uint8_t *ss, const uint8_t *epk, const uint8_t *coins);
 int pqcrystals_kyber512_avx2_dec(uint8_t *ss, const uint8_t *ct, const uint8_t *sk);
 
 #define pqcrystals_kyber512_90s_avx2_SECRETKEYBYTES pqcrystals_kyber512_SECRETKEYBYTES
@@ -3,12 +3,21 @@
 
 #include <stdint.h>
 #include "params.h"
+#include "indcpa.h"
 
 #define CRYPTO_SECRETKEYBYTES  KYBER_SECRETKEYBYTES
 #define CRYPTO_PUBLICKEYBYTES  KYBER_PUBLICKEYBYTES
 #define CRYPTO_CIPHERTEXTBYTES KYBER_CIPHERTEXTBYTES
 #define CRYPTO_BYTES           KYBER_SSBYTES
 
+/* Public key prepared for repeated encapsulations: expanded matrix A^T, unpacked t and H(pk) */
+typedef struct {
+  indcpa_expanded_pk indcpa;
+  uint8_t hpk[KYBER_SYMBYTES];
+} kem_expanded_pk;
+
+#define CRYPTO_EXPANDEDPUBLICKEYBYTES ((KYBER_K*KYBER_K+KYBER_K)*KYBER_N*2 + KYBER_SYMBYTES)
+
 #if   (KYBER_K == 2)
 #ifdef KYBER_90S
 #define CRYPTO_ALGNAME "Kyber512-90s"
@@ -29,9 +38,21 @@
 #endif
 #endif
 
+#define crypto_kem_keypair_derand KYBER_NAMESPACE(keypair_derand)
+int crypto_kem_keypair_derand(uint8_t *pk, uint8_t *sk, const uint8_t *coins);
+
 #define crypto_kem_keypair KYBER_NAMESPACE(keypair)
 int crypto_kem_keypair(uint8_t *pk, uint8_t *sk);
 
+#define crypto_kem_enc_derand KYBER_NAMESPACE(enc_derand)
+int crypto_kem_enc_derand(uint8_t *ct, uint8_t *ss, const uint8_t *pk, const uint8_t *coins);
+
+#define crypto_kem_expand_pk KYBER_NAMESPACE(expand_pk)
+int crypto_kem_expand_pk(uint8_t *epk, const uint8_t *pk);
+
+#define crypto_kem_enc_expanded_derand KYBER_NAMESPACE(enc_expanded_derand)
+int crypto_kem_enc_expanded_derand(uint8_t *ct, uint8_t *ss, const uint8_t *epk, const uint8_t *coins);
+
 #define crypto_kem_enc KYBER_NAMESPACE(enc)
 int crypto_kem_enc(uint8_t *ct, uint8_t *ss, const uint8_t *pk);
 
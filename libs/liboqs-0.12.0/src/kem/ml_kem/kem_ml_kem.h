@@ -10,10 +10,15 @@
 #define OQS_KEM_ml_kem_512_length_secret_key 1632
 #define OQS_KEM_ml_kem_512_length_ciphertext 768
 #define OQS_KEM_ml_kem_512_length_shared_secret 32
+#define OQS_KEM_ml_kem_512_length_keypair_seed 64
+#define OQS_KEM_ml_kem_512_length_encaps_seed 32
 OQS_KEM *OQS_KEM_ml_kem_512_new(void);
 OQS_API OQS_STATUS OQS_KEM_ml_kem_512_keypair(uint8_t *public_key, uint8_t *secret_key);
 OQS_API OQS_STATUS OQS_KEM_ml_kem_512_encaps(uint8_t *ciphertext, uint8_t *shared_secret, const uint8_t *public_key);
 OQS_API OQS_STATUS OQS_KEM_ml_kem_512_decaps(uint8_t *shared_secret, const uint8_t *ciphertext, const uint8_t *secret_key);
+/* Derandomized variants: all randomness is taken from the caller-supplied seed (keypair: d || z, encaps: m) */
+OQS_API OQS_STATUS OQS_KEM_ml_kem_512_keypair_derand(uint8_t *public_key, uint8_t *secret_key, const uint8_t *seed);
+OQS_API OQS_STATUS OQS_KEM_ml_kem_512_encaps_derand(uint8_t *ciphertext, uint8_t *shared_secret, const uint8_t *public_key, const uint8_t *seed);
 #endif
 
 #if defined(OQS_ENABLE_KEM_ml_kem_768)
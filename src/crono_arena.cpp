@@ -0,0 +1,115 @@
+#include "../include/crono_arena.h"
+#include <algorithm>
+
+namespace CronoUtils {
+
+    // Alle Größen und Offsets sind Vielfache davon, damit LIFO-Freigaben den Füllstand exakt zurücksetzen
+    static constexpr std::size_t GRANULE = alignof(std::max_align_t);
+
+    static std::size_t round_up(std::size_t n, std::size_t alignment) {
+        return (n + alignment - 1) & ~(alignment - 1);
+    }
+
+    ScratchArena::ScratchArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+        : upstream_(upstream ? upstream : std::pmr::new_delete_resource()) {
+        blocks_.reserve(8);
+        add_block(round_up(std::max<std::size_t>(capacity, GRANULE), GRANULE));
+    }
+
+    ScratchArena::~ScratchArena() {
+        for (const Block& block : blocks_) {
+            upstream_->deallocate(block.data, block.size, GRANULE);
+        }
+    }
+
+    void ScratchArena::add_block(std::size_t size) {
+        Block block{ static_cast<unsigned char*>(upstream_->allocate(size, GRANULE)), size };
+        upstream_allocations_++;
+        blocks_.push_back(block);
+        offset_ = 0;
+    }
+
+    // Ersetzt alle Blöcke durch einen einzigen mit ihrer Gesamtgröße (nur bei vollständig geleerter Arena)
+    void ScratchArena::consolidate() {
+        const std::size_t total = capacity();
+        for (const Block& block : blocks_) {
+            upstream_->deallocate(block.data, block.size, GRANULE);
+        }
+        blocks_.clear();
+        add_block(total);
+    }
+
+    void* ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+        bytes = round_up(std::max<std::size_t>(bytes, 1), GRANULE);
+        Block& block = blocks_.back();
+        std::size_t start = alignment > GRANULE ? round_up(offset_, alignment) : offset_;
+        if (start + bytes > block.size) {
+            // Neuer Block: mindestens doppelt so groß wie der bisherige
+            const std::size_t extra = alignment > GRANULE ? alignment : 0;
+            add_block(std::max(block.size * 2, round_up(bytes + extra, GRANULE)));
+            start = alignment > GRANULE ? round_up(offset_, alignment) : offset_;
+        }
+        unsigned char* p = blocks_.back().data + start;
+        offset_ = start + bytes;
+        return p;
+    }
+
+    void ScratchArena::do_deallocate(void* p, std::size_t bytes, std::size_t) {
+        // Nur die zuletzt vergebene Allokation lässt sich sofort zurückgeben; alles andere gibt rewind() frei
+        bytes = round_up(std::max<std::size_t>(bytes, 1), GRANULE);
+        const Block& block = blocks_.back();
+        if (static_cast<unsigned char*>(p) + bytes == block.data + offset_)
+            offset_ -= bytes;
+    }
+
+    void ScratchArena::rewind(const Mark& mark) {
+        if (mark.block + 1 < blocks_.size()) {
+            // Während des Aufrufs sind Blöcke hinzugekommen
+            if (mark.block == 0 && mark.offset == 0) {
+                consolidate();
+                return;
+            }
+            // Verschachtelte Marke: die neueren Blöcke bleiben bis zur äußersten Rücksetzung belegt
+            return;
+        }
+        offset_ = mark.offset;
+    }
+
+    std::size_t ScratchArena::used() const {
+        std::size_t total = offset_;
+        for (std::size_t i = 0; i + 1 < blocks_.size(); i++) {
+            total += blocks_[i].size;
+        }
+        return total;
+    }
+
+    std::size_t ScratchArena::capacity() const {
+        std::size_t total = 0;
+        for (const Block& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    ScratchArena& thread_arena() {
+        static thread_local ScratchArena arena;
+        return arena;
+    }
+
+    static thread_local std::pmr::memory_resource* activeScratch = nullptr;
+
+    std::pmr::memory_resource* scratch_resource() {
+        return activeScratch ? activeScratch : &thread_arena();
+    }
+
+    ScopedScratch::ScopedScratch(std::pmr::memory_resource* resource)
+        : previous_(activeScratch), mark_(thread_arena().mark()) {
+        if (resource != nullptr)
+            activeScratch = resource;
+    }
+
+    ScopedScratch::~ScopedScratch() {
+        activeScratch = previous_;
+        thread_arena().rewind(mark_);
+    }
+}
@@ -0,0 +1,132 @@
+#include "../include/crono_binding.h"
+#include "../include/crono_utils.h"
+#include <atomic>
+#include <thread>
+
+namespace CronoUtils {
+
+    static constexpr uint64_t BINDING_MODULUS = 0xFFFFFFFFFFFFFDULL;
+
+    // Ein Abtastfenster: Endzeitpunkt (Steady Clock in ns, kann von späteren Anfragen verschoben werden)
+    // und je Sampler der aktuelle Stand seines Faktors
+    struct BindingScheduler::Window {
+        Window(unsigned int samplers, uint64_t deadline)
+            : deadline_ns(deadline), slots(std::make_unique<std::atomic<uint64_t>[]>(samplers)), slot_count(samplers), active(samplers) {
+            for (unsigned int i = 0; i < samplers; i++) {
+                slots[i].store(1, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<uint64_t> deadline_ns;
+        std::unique_ptr<std::atomic<uint64_t>[]> slots;
+        const unsigned int slot_count;
+        unsigned int active;   // Laufende oder eingereihte Sampler; geschützt durch BindingScheduler::mutex_
+    };
+
+    BindingScheduler::BindingScheduler(WorkerPool& pool, unsigned int samplers)
+        : pool_(pool), samplers_(samplers > 0 ? samplers : (std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1)) {
+    }
+
+    BindingScheduler::~BindingScheduler() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // Laufendes Fenster sofort schließen und auf alle Sampler warten
+        if (current_)
+            current_->deadline_ns.store(0);
+        idle_.wait(lock, [this]() { return active_samplers_ == 0; });
+    }
+
+    // Ein Messwert, multiplikativ in den Slot gefaltet; Pool-Sampler und anfragende Threads können sich
+    // einen Slot teilen
+    void BindingScheduler::sample_once(Window& window, std::size_t slot) {
+        const uint64_t sample_val = ram_fingerprint() ^ cache_noise();
+        // Kurze Verzögerung, die der Compiler nicht entfernen darf
+        for (int j = 0; j < 50; j++) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        }
+        uint64_t current = window.slots[slot].load(std::memory_order_relaxed);
+        while (!window.slots[slot].compare_exchange_weak(current, (current * (sample_val | 1)) % BINDING_MODULUS, std::memory_order_relaxed)) {
+        }
+        samples_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void BindingScheduler::sample(const std::shared_ptr<Window>& window, std::size_t slot) {
+        for (;;) {
+            if (get_steady_time() >= window->deadline_ns.load()) {
+                // Unter dem Mutex erneut prüfen: eine Anfrage kann das Fenster gerade verlängert haben
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (get_steady_time() >= window->deadline_ns.load()) {
+                    window->active--;
+                    active_samplers_--;
+                    idle_.notify_all();
+                    return;
+                }
+                continue;
+            }
+            sample_once(*window, slot);
+        }
+    }
+
+    uint64_t BindingScheduler::bind(double duration_ms) {
+        const uint64_t end = get_steady_time() + static_cast<uint64_t>(duration_ms > 0.0 ? duration_ms * 1e6 : 0.0);
+        std::shared_ptr<Window> window;
+        uint64_t sequence = 0;
+        bool opened = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sequence = ++requests_;
+            if (current_ && current_->active > 0 && get_steady_time() < current_->deadline_ns.load()) {
+                // Laufendes Fenster mitnutzen und bei Bedarf bis zum eigenen Ende verlängern
+                coalesced_++;
+                if (current_->deadline_ns.load() < end)
+                    current_->deadline_ns.store(end);
+            }
+            else {
+                current_ = std::make_shared<Window>(samplers_, end);
+                active_samplers_ += samplers_;
+                windows_++;
+                opened = true;
+            }
+            window = current_;
+        }
+        // Erst nach dem Mutex einreihen: im Kindprozess nach fork() führt submit() den Sampler sofort aus
+        if (opened) {
+            for (unsigned int i = 0; i < samplers_; i++) {
+                pool_.submit([this, window, i]() { sample(window, i); });
+            }
+        }
+
+        // Bis zum eigenen Ende selbst einen Slot abtasten: Ist der Pool ausgelastet (etwa bei bind() aus
+        // parallel_for heraus), startet womöglich kein Sampler vor dem Endzeitpunkt
+        const std::size_t own_slot = static_cast<std::size_t>(sequence % window->slot_count);
+        do {
+            sample_once(*window, own_slot);
+        } while (get_steady_time() < end);
+
+        // Stand der gemeinsamen Samples zum eigenen Endzeitpunkt, dazu ein eigener Wert je Anfrage
+        uint64_t combined = 1;
+        for (unsigned int i = 0; i < window->slot_count; i++) {
+            combined *= (window->slots[i].load(std::memory_order_relaxed) | 1);
+            combined %= BINDING_MODULUS;
+        }
+        const uint64_t own = ram_fingerprint() ^ cache_noise() ^ rotate_left(get_tsc(), 17) ^ (sequence * 0x9E3779B97F4A7C15ULL);
+        combined *= (own | 1);
+        combined %= BINDING_MODULUS;
+        return combined;
+    }
+
+    BindingSchedulerStats BindingScheduler::stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        BindingSchedulerStats stats;
+        stats.requests = requests_;
+        stats.windows = windows_;
+        stats.coalesced = coalesced_;
+        stats.active_samplers = active_samplers_;
+        stats.samples = samples_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    BindingScheduler& BindingScheduler::shared() {
+        static BindingScheduler scheduler(WorkerPool::shared());
+        return scheduler;
+    }
+}
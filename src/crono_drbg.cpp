@@ -0,0 +1,189 @@
+#include "../include/crono_drbg.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <bcrypt.h>
+#pragma comment(lib, "bcrypt.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+#endif
+
+namespace CronoEntropy {
+
+    // --- Systemquelle ---
+
+    void system_random_bytes(uint8_t* out, std::size_t length) {
+#ifdef _WIN32
+        while (length > 0) {
+            const ULONG chunk = static_cast<ULONG>(length > 0x7FFFFFFF ? 0x7FFFFFFF : length);
+            if (!BCRYPT_SUCCESS(BCryptGenRandom(nullptr, out, chunk, BCRYPT_USE_SYSTEM_PREFERRED_RNG)))
+                std::abort();
+            out += chunk;
+            length -= chunk;
+        }
+#elif defined(__linux__)
+        while (length > 0) {
+            const ssize_t n = getrandom(out, length, 0);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                std::abort();
+            }
+            out += n;
+            length -= static_cast<std::size_t>(n);
+        }
+#else
+        static const int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+        while (length > 0) {
+            const ssize_t n = fd < 0 ? -1 : read(fd, out, length);
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR)
+                    continue;
+                std::abort();
+            }
+            out += n;
+            length -= static_cast<std::size_t>(n);
+        }
+#endif
+    }
+
+    // --- Erkennung von fork() ---
+
+    // Wird im Kindprozess erhöht; jeder DRBG vergleicht den Wert mit dem Stand seines letzten Seedings
+    static std::atomic<uint64_t> forkGeneration{ 0 };
+
+    static uint64_t fork_generation() {
+#ifndef _WIN32
+        static std::once_flag registered;
+        std::call_once(registered, []() {
+            pthread_atfork(nullptr, nullptr, []() { forkGeneration.fetch_add(1, std::memory_order_relaxed); });
+        });
+#endif
+        return forkGeneration.load(std::memory_order_relaxed);
+    }
+
+    // --- ChaCha20 (RFC 8439) ---
+
+    static inline uint32_t rotl32(uint32_t v, int c) {
+        return (v << c) | (v >> (32 - c));
+    }
+
+    static inline void quarter_round(uint32_t* s, int a, int b, int c, int d) {
+        s[a] += s[b]; s[d] ^= s[a]; s[d] = rotl32(s[d], 16);
+        s[c] += s[d]; s[b] ^= s[c]; s[b] = rotl32(s[b], 12);
+        s[a] += s[b]; s[d] ^= s[a]; s[d] = rotl32(s[d], 8);
+        s[c] += s[d]; s[b] ^= s[c]; s[b] = rotl32(s[b], 7);
+    }
+
+    // Ein 64-Byte-Block; Nonce ist null, der Blockzähler belegt die Worte 12 und 13
+    static void chacha20_block(const uint32_t key[8], uint64_t counter, uint8_t out[64]) {
+        uint32_t state[16] = {
+            0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+            key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+            static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0
+        };
+        uint32_t working[16];
+        std::memcpy(working, state, sizeof(working));
+        for (int i = 0; i < 10; i++) {
+            quarter_round(working, 0, 4, 8, 12);
+            quarter_round(working, 1, 5, 9, 13);
+            quarter_round(working, 2, 6, 10, 14);
+            quarter_round(working, 3, 7, 11, 15);
+            quarter_round(working, 0, 5, 10, 15);
+            quarter_round(working, 1, 6, 11, 12);
+            quarter_round(working, 2, 7, 8, 13);
+            quarter_round(working, 3, 4, 9, 14);
+        }
+        for (int i = 0; i < 16; i++) {
+            const uint32_t word = working[i] + state[i];
+            out[4 * i] = static_cast<uint8_t>(word);
+            out[4 * i + 1] = static_cast<uint8_t>(word >> 8);
+            out[4 * i + 2] = static_cast<uint8_t>(word >> 16);
+            out[4 * i + 3] = static_cast<uint8_t>(word >> 24);
+        }
+    }
+
+    static void load_key(uint32_t key[8], const uint8_t* bytes) {
+        for (int i = 0; i < 8; i++) {
+            key[i] = static_cast<uint32_t>(bytes[4 * i]) | (static_cast<uint32_t>(bytes[4 * i + 1]) << 8) |
+                (static_cast<uint32_t>(bytes[4 * i + 2]) << 16) | (static_cast<uint32_t>(bytes[4 * i + 3]) << 24);
+        }
+    }
+
+    // Löschen, das der Compiler nicht wegoptimieren darf
+    static void secure_zero(void* p, std::size_t length) {
+        volatile uint8_t* bytes = static_cast<volatile uint8_t*>(p);
+        while (length--)
+            *bytes++ = 0;
+    }
+
+    // --- DRBG ---
+
+    ChaCha20Drbg::~ChaCha20Drbg() {
+        secure_zero(key_, sizeof(key_));
+        secure_zero(buffer_, sizeof(buffer_));
+    }
+
+    void ChaCha20Drbg::seed(const uint8_t* seed) {
+        load_key(key_, seed);
+        secure_zero(buffer_, sizeof(buffer_));
+        available_ = 0;
+        bytes_since_seed_ = 0;
+        fork_generation_ = fork_generation();
+        seeded_ = true;
+    }
+
+    void ChaCha20Drbg::reseed_from_system() {
+        uint8_t seed_bytes[SEED_BYTES];
+        system_random_bytes(seed_bytes, sizeof(seed_bytes));
+        seed(seed_bytes);
+        secure_zero(seed_bytes, sizeof(seed_bytes));
+        reseeds_++;
+    }
+
+    void ChaCha20Drbg::refill() {
+        for (std::size_t b = 0; b < BLOCKS; b++) {
+            chacha20_block(key_, b, buffer_ + b * BLOCK_BYTES);
+        }
+        // Die ersten 32 Bytes ersetzen den Schlüssel: frühere Ausgaben lassen sich danach nicht mehr rekonstruieren
+        load_key(key_, buffer_);
+        secure_zero(buffer_, SEED_BYTES);
+        available_ = sizeof(buffer_) - SEED_BYTES;
+    }
+
+    void ChaCha20Drbg::generate(uint8_t* out, std::size_t length) {
+        if (!seeded_ || bytes_since_seed_ >= RESEED_INTERVAL || fork_generation_ != fork_generation())
+            reseed_from_system();
+        bytes_since_seed_ += length;
+        while (length > 0) {
+            if (available_ == 0)
+                refill();
+            const std::size_t offset = sizeof(buffer_) - available_;
+            const std::size_t n = length < available_ ? length : available_;
+            std::memcpy(out, buffer_ + offset, n);
+            secure_zero(buffer_ + offset, n);
+            available_ -= n;
+            out += n;
+            length -= n;
+        }
+    }
+
+    ChaCha20Drbg& thread_drbg() {
+        static thread_local ChaCha20Drbg drbg;
+        return drbg;
+    }
+
+    void drbg_random_bytes(uint8_t* out, std::size_t length) {
+        thread_drbg().generate(out, length);
+    }
+}
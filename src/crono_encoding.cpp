@@ -0,0 +1,704 @@
+#include "../include/crono_encoding.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CRONO_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang benötigen die Zielarchitektur pro Funktion, MSVC erlaubt Intrinsics ohne Flag
+#if defined(CRONO_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CRONO_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define CRONO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CRONO_TARGET_SSSE3
+#define CRONO_TARGET_AVX2
+#endif
+
+namespace CronoHash {
+
+    static const char HEX_ALPHABET[] = "0123456789abcdef";
+    static const char BASE64URL_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    static const char BASE32_ALPHABET[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+    // Dekodiertabellen: Zeichen -> Wert, 0xFF für ungültige Zeichen (Bit 7 gesetzt, gültige Werte < 64)
+    static constexpr uint8_t INVALID = 0xFF;
+
+    struct DecodeTables {
+        std::array<uint8_t, 256> hex;
+        std::array<uint8_t, 256> base64url;
+        std::array<uint8_t, 256> base32;
+    };
+
+    static const DecodeTables decodeTables = []() {
+        DecodeTables tables;
+        tables.hex.fill(INVALID);
+        tables.base64url.fill(INVALID);
+        tables.base32.fill(INVALID);
+        for (uint8_t v = 0; v < 16; v++) {
+            tables.hex[static_cast<uint8_t>(HEX_ALPHABET[v])] = v;
+        }
+        for (uint8_t v = 0; v < 6; v++) {
+            tables.hex['A' + v] = static_cast<uint8_t>(10 + v);
+        }
+        for (uint8_t v = 0; v < 64; v++) {
+            tables.base64url[static_cast<uint8_t>(BASE64URL_ALPHABET[v])] = v;
+        }
+        for (uint8_t v = 0; v < 32; v++) {
+            const char c = BASE32_ALPHABET[v];
+            tables.base32[static_cast<uint8_t>(c)] = v;
+            if (c >= 'A' && c <= 'Z')
+                tables.base32[static_cast<uint8_t>(c - 'A' + 'a')] = v;
+        }
+        // Crockford: leicht verwechselbare Zeichen werden beim Lesen zugeordnet
+        tables.base32['O'] = tables.base32['o'] = 0;
+        tables.base32['I'] = tables.base32['i'] = 1;
+        tables.base32['L'] = tables.base32['l'] = 1;
+        return tables;
+        }();
+
+    // --- Skalare Kodierer (Referenz und Rest nach den SIMD-Blöcken) ---
+
+    static void hex_encode_scalar(const uint8_t* in, std::size_t n, char* out) {
+        for (std::size_t i = 0; i < n; i++) {
+            out[2 * i] = HEX_ALPHABET[in[i] >> 4];
+            out[2 * i + 1] = HEX_ALPHABET[in[i] & 0x0F];
+        }
+    }
+
+    static bool hex_decode_scalar(const char* in, std::size_t chars, uint8_t* out) {
+        uint8_t bad = 0;
+        for (std::size_t i = 0; i < chars / 2; i++) {
+            const uint8_t hi = decodeTables.hex[static_cast<uint8_t>(in[2 * i])];
+            const uint8_t lo = decodeTables.hex[static_cast<uint8_t>(in[2 * i + 1])];
+            bad |= hi | lo;
+            out[i] = static_cast<uint8_t>((hi << 4) | (lo & 0x0F));
+        }
+        return (bad & 0x80) == 0;
+    }
+
+    static void base64url_encode_scalar(const uint8_t* in, std::size_t n, char* out) {
+        std::size_t i = 0;
+        for (; i + 3 <= n; i += 3) {
+            const uint32_t v = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8) | in[i + 2];
+            *out++ = BASE64URL_ALPHABET[(v >> 18) & 63];
+            *out++ = BASE64URL_ALPHABET[(v >> 12) & 63];
+            *out++ = BASE64URL_ALPHABET[(v >> 6) & 63];
+            *out++ = BASE64URL_ALPHABET[v & 63];
+        }
+        if (n - i == 1) {
+            const uint32_t v = static_cast<uint32_t>(in[i]) << 16;
+            *out++ = BASE64URL_ALPHABET[(v >> 18) & 63];
+            *out++ = BASE64URL_ALPHABET[(v >> 12) & 63];
+        }
+        else if (n - i == 2) {
+            const uint32_t v = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8);
+            *out++ = BASE64URL_ALPHABET[(v >> 18) & 63];
+            *out++ = BASE64URL_ALPHABET[(v >> 12) & 63];
+            *out++ = BASE64URL_ALPHABET[(v >> 6) & 63];
+        }
+    }
+
+    static bool base64url_decode_scalar(const char* in, std::size_t chars, uint8_t* out) {
+        uint8_t bad = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= chars; i += 4) {
+            const uint8_t a = decodeTables.base64url[static_cast<uint8_t>(in[i])];
+            const uint8_t b = decodeTables.base64url[static_cast<uint8_t>(in[i + 1])];
+            const uint8_t c = decodeTables.base64url[static_cast<uint8_t>(in[i + 2])];
+            const uint8_t d = decodeTables.base64url[static_cast<uint8_t>(in[i + 3])];
+            bad |= a | b | c | d;
+            const uint32_t v = (static_cast<uint32_t>(a & 63) << 18) | (static_cast<uint32_t>(b & 63) << 12) | (static_cast<uint32_t>(c & 63) << 6) | (d & 63);
+            *out++ = static_cast<uint8_t>(v >> 16);
+            *out++ = static_cast<uint8_t>(v >> 8);
+            *out++ = static_cast<uint8_t>(v);
+        }
+        const std::size_t rest = chars - i;
+        if (rest >= 2) {
+            const uint8_t a = decodeTables.base64url[static_cast<uint8_t>(in[i])];
+            const uint8_t b = decodeTables.base64url[static_cast<uint8_t>(in[i + 1])];
+            const uint8_t c = rest == 3 ? decodeTables.base64url[static_cast<uint8_t>(in[i + 2])] : 0;
+            bad |= a | b | c;
+            const uint32_t v = (static_cast<uint32_t>(a & 63) << 18) | (static_cast<uint32_t>(b & 63) << 12) | (static_cast<uint32_t>(c & 63) << 6);
+            *out++ = static_cast<uint8_t>(v >> 16);
+            if (rest == 3)
+                *out++ = static_cast<uint8_t>(v >> 8);
+            // Ungenutzte Bits der letzten Gruppe müssen null sein
+            if ((v & (rest == 2 ? 0xFFFFu : 0xFFu)) != 0)
+                return false;
+        }
+        return (bad & 0x80) == 0;
+    }
+
+    static void base32_encode_scalar(const uint8_t* in, std::size_t n, char* out) {
+        std::size_t i = 0;
+        for (; i + 5 <= n; i += 5) {
+            uint64_t v = 0;
+            for (int j = 0; j < 5; j++) {
+                v = (v << 8) | in[i + j];
+            }
+            for (int k = 0; k < 8; k++) {
+                *out++ = BASE32_ALPHABET[(v >> (35 - 5 * k)) & 31];
+            }
+        }
+        const std::size_t rest = n - i;
+        if (rest > 0) {
+            uint64_t v = 0;
+            for (std::size_t j = 0; j < rest; j++) {
+                v |= static_cast<uint64_t>(in[i + j]) << (32 - 8 * j);
+            }
+            const std::size_t chars = (rest * 8 + 4) / 5;
+            for (std::size_t k = 0; k < chars; k++) {
+                *out++ = BASE32_ALPHABET[(v >> (35 - 5 * k)) & 31];
+            }
+        }
+    }
+
+    static bool base32_decode_scalar(const char* in, std::size_t chars, uint8_t* out) {
+        uint8_t bad = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= chars; i += 8) {
+            uint64_t v = 0;
+            for (int k = 0; k < 8; k++) {
+                const uint8_t value = decodeTables.base32[static_cast<uint8_t>(in[i + k])];
+                bad |= value;
+                v = (v << 5) | (value & 31);
+            }
+            for (int j = 0; j < 5; j++) {
+                *out++ = static_cast<uint8_t>(v >> (32 - 8 * j));
+            }
+        }
+        const std::size_t rest = chars - i;
+        if (rest > 0) {
+            uint64_t v = 0;
+            for (std::size_t k = 0; k < rest; k++) {
+                const uint8_t value = decodeTables.base32[static_cast<uint8_t>(in[i + k])];
+                bad |= value;
+                v |= static_cast<uint64_t>(value & 31) << (35 - 5 * k);
+            }
+            const std::size_t bytes = rest * 5 / 8;
+            for (std::size_t j = 0; j < bytes; j++) {
+                *out++ = static_cast<uint8_t>(v >> (32 - 8 * j));
+            }
+            if ((v & ((1ULL << (40 - 8 * bytes)) - 1)) != 0)
+                return false;
+        }
+        return (bad & 0x80) == 0;
+    }
+
+    // --- SSSE3/AVX2-Kodierer ---
+
+#ifdef CRONO_X86
+    // Maske der Bytes mit v <= max (vorzeichenlos)
+    static inline __m128i at_most(__m128i v, char max) {
+        return _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(max)), v);
+    }
+
+    CRONO_TARGET_AVX2 static inline __m256i at_most(__m256i v, char max) {
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(max)), v);
+    }
+
+    // Hex: Nibbles per pshufb auf das Alphabet abbilden und verschränken
+    CRONO_TARGET_SSSE3 static void hex_encode_ssse3(const uint8_t* in, std::size_t n, char* out) {
+        const __m128i alphabet = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_ALPHABET));
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i hi = _mm_shuffle_epi8(alphabet, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+            const __m128i lo = _mm_shuffle_epi8(alphabet, _mm_and_si128(v, nibble));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+        }
+        hex_encode_scalar(in + i, n - i, out + 2 * i);
+    }
+
+    CRONO_TARGET_AVX2 static void hex_encode_avx2(const uint8_t* in, std::size_t n, char* out) {
+        const __m256i alphabet = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_ALPHABET)));
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i hi = _mm256_shuffle_epi8(alphabet, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+            const __m256i lo = _mm256_shuffle_epi8(alphabet, _mm256_and_si256(v, nibble));
+            // unpack arbeitet je 128-Bit-Hälfte: Bytes 0-7/16-23 und 8-15/24-31 wieder in Reihenfolge bringen
+            const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+            const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+        }
+        // Der Rest läuft im SSE-Kernel ohne VEX-Kodierung: obere Registerhälften vorher leeren
+        _mm256_zeroupper();
+        hex_encode_ssse3(in + i, n - i, out + 2 * i);
+    }
+
+    // Hex-Zeichen -> Nibble; valid markiert Ziffern und a-f/A-F
+    static inline __m128i hex_values(__m128i c, __m128i& valid) {
+        const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i digit_mask = at_most(digit, 9);
+        const __m128i letter_mask = at_most(letter, 5);
+        valid = _mm_or_si128(digit_mask, letter_mask);
+        return _mm_or_si128(_mm_and_si128(digit_mask, digit),
+            _mm_and_si128(letter_mask, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    }
+
+    CRONO_TARGET_AVX2 static inline __m256i hex_values(__m256i c, __m256i& valid) {
+        const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        const __m256i digit_mask = at_most(digit, 9);
+        const __m256i letter_mask = at_most(letter, 5);
+        valid = _mm256_or_si256(digit_mask, letter_mask);
+        return _mm256_or_si256(_mm256_and_si256(digit_mask, digit),
+            _mm256_and_si256(letter_mask, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+    }
+
+    CRONO_TARGET_SSSE3 static bool hex_decode_ssse3(const char* in, std::size_t chars, uint8_t* out) {
+        std::size_t i = 0;
+        for (; i + 16 <= chars; i += 16) {
+            __m128i valid;
+            const __m128i values = hex_values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), valid);
+            if (_mm_movemask_epi8(valid) != 0xFFFF)
+                return false;
+            // Paare (hi, lo) -> hi * 16 + lo
+            const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i / 2), _mm_packus_epi16(pairs, pairs));
+        }
+        return hex_decode_scalar(in + i, chars - i, out + i / 2);
+    }
+
+    CRONO_TARGET_AVX2 static bool hex_decode_avx2(const char* in, std::size_t chars, uint8_t* out) {
+        std::size_t i = 0;
+        for (; i + 32 <= chars; i += 32) {
+            __m256i valid;
+            const __m256i values = hex_values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), valid);
+            if (_mm256_movemask_epi8(valid) != -1)
+                return false;
+            const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs, pairs), 0xD8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), _mm256_castsi256_si128(packed));
+        }
+        _mm256_zeroupper();
+        return hex_decode_ssse3(in + i, chars - i, out + i / 2);
+    }
+
+    // Base64url: 12 Bytes -> 16 Indizes per Multiplikations-Shift, danach Offset je Indexbereich addieren
+    CRONO_TARGET_SSSE3 static inline __m128i base64url_chars(__m128i in) {
+        in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t0, t1);
+        // 0-25 -> 13 ('A'), 26-51 -> 0 ('a'), 52-61 -> 1..10 ('0'), 62 -> 11 ('-'), 63 -> 12 ('_')
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+        return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+    }
+
+    CRONO_TARGET_AVX2 static inline __m256i base64url_chars(__m256i in) {
+        in = _mm256_shuffle_epi8(in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t0, t1);
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+        const __m256i offsets = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0,
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0);
+        return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+    }
+
+    CRONO_TARGET_SSSE3 static void base64url_encode_ssse3(const uint8_t* in, std::size_t n, char* out) {
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 12) {
+            const __m128i chars = base64url_chars(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 3 * 4), chars);
+        }
+        base64url_encode_scalar(in + i, n - i, out + i / 3 * 4);
+    }
+
+    CRONO_TARGET_AVX2 static void base64url_encode_avx2(const uint8_t* in, std::size_t n, char* out) {
+        std::size_t i = 0;
+        for (; i + 28 <= n; i += 24) {
+            const __m256i v = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 3 * 4), base64url_chars(v));
+        }
+        _mm256_zeroupper();
+        base64url_encode_ssse3(in + i, n - i, out + i / 3 * 4);
+    }
+
+    // Base64url-Zeichen -> 6-Bit-Wert über Bereichsvergleiche
+    static inline __m128i base64url_values(__m128i c, __m128i& valid) {
+        const __m128i upper = _mm_sub_epi8(c, _mm_set1_epi8('A'));
+        const __m128i lower = _mm_sub_epi8(c, _mm_set1_epi8('a'));
+        const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        const __m128i upper_mask = at_most(upper, 25);
+        const __m128i lower_mask = at_most(lower, 25);
+        const __m128i digit_mask = at_most(digit, 9);
+        const __m128i minus = _mm_cmpeq_epi8(c, _mm_set1_epi8('-'));
+        const __m128i underscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+        valid = _mm_or_si128(_mm_or_si128(upper_mask, lower_mask), _mm_or_si128(digit_mask, _mm_or_si128(minus, underscore)));
+        __m128i values = _mm_and_si128(upper_mask, upper);
+        values = _mm_or_si128(values, _mm_and_si128(lower_mask, _mm_add_epi8(lower, _mm_set1_epi8(26))));
+        values = _mm_or_si128(values, _mm_and_si128(digit_mask, _mm_add_epi8(digit, _mm_set1_epi8(52))));
+        values = _mm_or_si128(values, _mm_and_si128(minus, _mm_set1_epi8(62)));
+        return _mm_or_si128(values, _mm_and_si128(underscore, _mm_set1_epi8(63)));
+    }
+
+    CRONO_TARGET_AVX2 static inline __m256i base64url_values(__m256i c, __m256i& valid) {
+        const __m256i upper = _mm256_sub_epi8(c, _mm256_set1_epi8('A'));
+        const __m256i lower = _mm256_sub_epi8(c, _mm256_set1_epi8('a'));
+        const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        const __m256i upper_mask = at_most(upper, 25);
+        const __m256i lower_mask = at_most(lower, 25);
+        const __m256i digit_mask = at_most(digit, 9);
+        const __m256i minus = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-'));
+        const __m256i underscore = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_'));
+        valid = _mm256_or_si256(_mm256_or_si256(upper_mask, lower_mask), _mm256_or_si256(digit_mask, _mm256_or_si256(minus, underscore)));
+        __m256i values = _mm256_and_si256(upper_mask, upper);
+        values = _mm256_or_si256(values, _mm256_and_si256(lower_mask, _mm256_add_epi8(lower, _mm256_set1_epi8(26))));
+        values = _mm256_or_si256(values, _mm256_and_si256(digit_mask, _mm256_add_epi8(digit, _mm256_set1_epi8(52))));
+        values = _mm256_or_si256(values, _mm256_and_si256(minus, _mm256_set1_epi8(62)));
+        return _mm256_or_si256(values, _mm256_and_si256(underscore, _mm256_set1_epi8(63)));
+    }
+
+    // Je vier 6-Bit-Werte -> 24 Bit (a << 18 | b << 12 | c << 6 | d), danach Big-Endian-Bytes je Gruppe
+    CRONO_TARGET_SSSE3 static bool base64url_decode_ssse3(const char* in, std::size_t chars, uint8_t* out) {
+        const __m128i order = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        std::size_t i = 0;
+        for (; i + 16 <= chars; i += 16) {
+            __m128i valid;
+            const __m128i values = base64url_values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), valid);
+            if (_mm_movemask_epi8(valid) != 0xFFFF)
+                return false;
+            const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+            const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+            alignas(16) uint8_t bytes[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(bytes), _mm_shuffle_epi8(groups, order));
+            std::memcpy(out + i / 4 * 3, bytes, 12);
+        }
+        return base64url_decode_scalar(in + i, chars - i, out + i / 4 * 3);
+    }
+
+    CRONO_TARGET_AVX2 static bool base64url_decode_avx2(const char* in, std::size_t chars, uint8_t* out) {
+        const __m256i order = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        std::size_t i = 0;
+        for (; i + 32 <= chars; i += 32) {
+            __m256i valid;
+            const __m256i values = base64url_values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), valid);
+            if (_mm256_movemask_epi8(valid) != -1)
+                return false;
+            const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+            alignas(32) uint8_t bytes[32];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(bytes), _mm256_shuffle_epi8(groups, order));
+            std::memcpy(out + i / 4 * 3, bytes, 12);
+            std::memcpy(out + i / 4 * 3 + 12, bytes + 16, 12);
+        }
+        _mm256_zeroupper();
+        return base64url_decode_ssse3(in + i, chars - i, out + i / 4 * 3);
+    }
+
+    // Base32: Je 16-Bit-Lane das Bytepaar, das einen 5-Bit-Index enthält (Big-Endian), dann variabler
+    // Rechtsshift um 11, 6, 9, 4, 7, 10, 5, 8 per mulhi mit 2^(16 - Shift)
+    CRONO_TARGET_SSSE3 static inline __m128i base32_chars(__m128i indices) {
+        const __m128i low = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+        const __m128i high = _mm_setr_epi8('G', 'H', 'J', 'K', 'M', 'N', 'P', 'Q', 'R', 'S', 'T', 'V', 'W', 'X', 'Y', 'Z');
+        const __m128i upper_half = _mm_cmpgt_epi8(indices, _mm_set1_epi8(15));
+        return _mm_or_si128(_mm_and_si128(upper_half, _mm_shuffle_epi8(high, indices)),
+            _mm_andnot_si128(upper_half, _mm_shuffle_epi8(low, indices)));
+    }
+
+    CRONO_TARGET_SSSE3 static void base32_encode_ssse3(const uint8_t* in, std::size_t n, char* out) {
+        const __m128i first = _mm_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, -128, 4);
+        const __m128i second = _mm_setr_epi8(6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, -128, 9);
+        const __m128i shifts = _mm_setr_epi16(32, 1024, 128, 4096, 512, 64, 2048, 256);
+        const __m128i five_bits = _mm_set1_epi16(31);
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 10) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i a = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(v, first), shifts), five_bits);
+            const __m128i b = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(v, second), shifts), five_bits);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 5 * 8), base32_chars(_mm_packus_epi16(a, b)));
+        }
+        base32_encode_scalar(in + i, n - i, out + i / 5 * 8);
+    }
+
+    CRONO_TARGET_AVX2 static void base32_encode_avx2(const uint8_t* in, std::size_t n, char* out) {
+        const __m256i first = _mm256_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, -128, 4,
+            1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, -128, 4);
+        const __m256i second = _mm256_setr_epi8(6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, -128, 9,
+            6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, -128, 9);
+        const __m256i shifts = _mm256_setr_epi16(32, 1024, 128, 4096, 512, 64, 2048, 256, 32, 1024, 128, 4096, 512, 64, 2048, 256);
+        const __m256i five_bits = _mm256_set1_epi16(31);
+        const __m256i low = _mm256_broadcastsi128_si256(_mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'));
+        const __m256i high = _mm256_broadcastsi128_si256(_mm_setr_epi8('G', 'H', 'J', 'K', 'M', 'N', 'P', 'Q', 'R', 'S', 'T', 'V', 'W', 'X', 'Y', 'Z'));
+        std::size_t i = 0;
+        for (; i + 26 <= n; i += 20) {
+            // Hälfte 0: Gruppen 0 und 1, Hälfte 1: Gruppen 2 und 3 – packus erhält damit die Reihenfolge
+            const __m256i v = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 10)), 1);
+            const __m256i a = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(v, first), shifts), five_bits);
+            const __m256i b = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(v, second), shifts), five_bits);
+            const __m256i indices = _mm256_packus_epi16(a, b);
+            const __m256i upper_half = _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(15));
+            const __m256i chars = _mm256_or_si256(_mm256_and_si256(upper_half, _mm256_shuffle_epi8(high, indices)),
+                _mm256_andnot_si256(upper_half, _mm256_shuffle_epi8(low, indices)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 5 * 8), chars);
+        }
+        _mm256_zeroupper();
+        base32_encode_ssse3(in + i, n - i, out + i / 5 * 8);
+    }
+
+    // Crockford-Zeichen -> 5-Bit-Wert. Buchstaben werden klein gefaltet und über zwei Tabellen (a-p, q-z)
+    // abgebildet; 0xFF markiert U.
+    CRONO_TARGET_SSSE3 static inline __m128i base32_values(__m128i c, __m128i& valid) {
+        const __m128i first = _mm_setr_epi8(10, 11, 12, 13, 14, 15, 16, 17, 1, 18, 19, 1, 20, 21, 0, 22);
+        const __m128i second = _mm_setr_epi8(23, 24, 25, 26, -1, 27, 28, 29, 30, 31, -1, -1, -1, -1, -1, -1);
+        const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i digit_mask = at_most(digit, 9);
+        const __m128i second_half = _mm_cmpgt_epi8(letter, _mm_set1_epi8(15));
+        const __m128i letter_value = _mm_or_si128(_mm_and_si128(second_half, _mm_shuffle_epi8(second, letter)),
+            _mm_andnot_si128(second_half, _mm_shuffle_epi8(first, letter)));
+        const __m128i letter_mask = _mm_andnot_si128(_mm_cmpeq_epi8(letter_value, _mm_set1_epi8(-1)), at_most(letter, 25));
+        valid = _mm_or_si128(digit_mask, letter_mask);
+        return _mm_or_si128(_mm_and_si128(digit_mask, digit), _mm_and_si128(letter_mask, letter_value));
+    }
+
+    CRONO_TARGET_AVX2 static inline __m256i base32_values(__m256i c, __m256i& valid) {
+        const __m256i first = _mm256_broadcastsi128_si256(_mm_setr_epi8(10, 11, 12, 13, 14, 15, 16, 17, 1, 18, 19, 1, 20, 21, 0, 22));
+        const __m256i second = _mm256_broadcastsi128_si256(_mm_setr_epi8(23, 24, 25, 26, -1, 27, 28, 29, 30, 31, -1, -1, -1, -1, -1, -1));
+        const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        const __m256i digit_mask = at_most(digit, 9);
+        const __m256i second_half = _mm256_cmpgt_epi8(letter, _mm256_set1_epi8(15));
+        const __m256i letter_value = _mm256_or_si256(_mm256_and_si256(second_half, _mm256_shuffle_epi8(second, letter)),
+            _mm256_andnot_si256(second_half, _mm256_shuffle_epi8(first, letter)));
+        const __m256i letter_mask = _mm256_andnot_si256(_mm256_cmpeq_epi8(letter_value, _mm256_set1_epi8(-1)), at_most(letter, 25));
+        valid = _mm256_or_si256(digit_mask, letter_mask);
+        return _mm256_or_si256(_mm256_and_si256(digit_mask, digit), _mm256_and_si256(letter_mask, letter_value));
+    }
+
+    // Acht 5-Bit-Werte -> 40 Bit: Paare zu 10 Bit (maddubs), Paare davon zu 20 Bit (madd),
+    // die beiden 20-Bit-Hälften einer 64-Bit-Lane zusammenschieben und Big-Endian ausgeben
+    CRONO_TARGET_SSSE3 static bool base32_decode_ssse3(const char* in, std::size_t chars, uint8_t* out) {
+        const __m128i order = _mm_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1);
+        const __m128i high_half = _mm_set1_epi64x(0x000000FFFFF00000LL);
+        std::size_t i = 0;
+        for (; i + 16 <= chars; i += 16) {
+            __m128i valid;
+            const __m128i values = base32_values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), valid);
+            if (_mm_movemask_epi8(valid) != 0xFFFF)
+                return false;
+            const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0120));
+            const __m128i quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00010400));
+            const __m128i groups = _mm_or_si128(_mm_and_si128(_mm_slli_epi64(quads, 20), high_half), _mm_srli_epi64(quads, 32));
+            alignas(16) uint8_t bytes[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(bytes), _mm_shuffle_epi8(groups, order));
+            std::memcpy(out + i / 8 * 5, bytes, 10);
+        }
+        return base32_decode_scalar(in + i, chars - i, out + i / 8 * 5);
+    }
+
+    CRONO_TARGET_AVX2 static bool base32_decode_avx2(const char* in, std::size_t chars, uint8_t* out) {
+        const __m256i order = _mm256_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1,
+            4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1);
+        const __m256i high_half = _mm256_set1_epi64x(0x000000FFFFF00000LL);
+        std::size_t i = 0;
+        for (; i + 32 <= chars; i += 32) {
+            __m256i valid;
+            const __m256i values = base32_values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), valid);
+            if (_mm256_movemask_epi8(valid) != -1)
+                return false;
+            const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0120));
+            const __m256i quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00010400));
+            const __m256i groups = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi64(quads, 20), high_half), _mm256_srli_epi64(quads, 32));
+            alignas(32) uint8_t bytes[32];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(bytes), _mm256_shuffle_epi8(groups, order));
+            std::memcpy(out + i / 8 * 5, bytes, 10);
+            std::memcpy(out + i / 8 * 5 + 10, bytes + 16, 10);
+        }
+        _mm256_zeroupper();
+        return base32_decode_ssse3(in + i, chars - i, out + i / 8 * 5);
+    }
+
+    static bool cpu_supports(EncodingLevel level) {
+        if (level == EncodingLevel::Scalar)
+            return true;
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        if (level == EncodingLevel::SSSE3)
+            return __builtin_cpu_supports("ssse3");
+        return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+        int regs[4] = { 0 };
+        __cpuid(regs, 0);
+        const int max_leaf = regs[0];
+        __cpuid(regs, 1);
+        if (level == EncodingLevel::SSSE3)
+            return (regs[2] & (1 << 9)) != 0;
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        if (max_leaf < 7 || !osxsave)
+            return false;
+        const unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(regs, 7, 0);
+        return (xcr0 & 0x6) == 0x6 && (regs[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }
+#else
+    static bool cpu_supports(EncodingLevel level) {
+        return level == EncodingLevel::Scalar;
+    }
+#endif
+
+    struct EncodingKernels {
+        EncodingLevel level;
+        void (*encode[3])(const uint8_t*, std::size_t, char*);
+        bool (*decode[3])(const char*, std::size_t, uint8_t*);
+    };
+
+    static constexpr EncodingKernels scalarKernels = { EncodingLevel::Scalar, { hex_encode_scalar, base64url_encode_scalar, base32_encode_scalar },
+        { hex_decode_scalar, base64url_decode_scalar, base32_decode_scalar } };
+#ifdef CRONO_X86
+    static constexpr EncodingKernels ssse3Kernels = { EncodingLevel::SSSE3, { hex_encode_ssse3, base64url_encode_ssse3, base32_encode_ssse3 },
+        { hex_decode_ssse3, base64url_decode_ssse3, base32_decode_ssse3 } };
+    static constexpr EncodingKernels avx2Kernels = { EncodingLevel::AVX2, { hex_encode_avx2, base64url_encode_avx2, base32_encode_avx2 },
+        { hex_decode_avx2, base64url_decode_avx2, base32_decode_avx2 } };
+#endif
+
+    static const EncodingKernels* kernels_for(EncodingLevel level) {
+#ifdef CRONO_X86
+        if (level == EncodingLevel::AVX2)
+            return &avx2Kernels;
+        if (level == EncodingLevel::SSSE3)
+            return &ssse3Kernels;
+#endif
+        return &scalarKernels;
+    }
+
+    // CPUID-Dispatch: Einmal beim Laden des Moduls die beste Variante wählen; atomarer Zeiger auf
+    // unveränderliche Tabellen wie bei den Wortkerneln in crono_math.cpp
+    static std::atomic<const EncodingKernels*> activeKernels = []() {
+        if (cpu_supports(EncodingLevel::AVX2))
+            return kernels_for(EncodingLevel::AVX2);
+        if (cpu_supports(EncodingLevel::SSSE3))
+            return kernels_for(EncodingLevel::SSSE3);
+        return kernels_for(EncodingLevel::Scalar);
+        }();
+
+    EncodingLevel encoding_level() {
+        return activeKernels.load(std::memory_order_acquire)->level;
+    }
+
+    bool force_encoding_level(EncodingLevel level) {
+        if (!cpu_supports(level))
+            return false;
+        activeKernels.store(kernels_for(level), std::memory_order_release);
+        return true;
+    }
+
+    // --- Öffentliche Schnittstelle ---
+
+    const char* encoding_name(Encoding encoding) {
+        switch (encoding) {
+        case Encoding::Hex:       return "hex";
+        case Encoding::Base64Url: return "base64url";
+        case Encoding::Base32:    return "base32";
+        }
+        return "unknown";
+    }
+
+    bool parse_encoding(std::string_view name, Encoding& encoding) {
+        for (Encoding candidate : { Encoding::Hex, Encoding::Base64Url, Encoding::Base32 }) {
+            if (name == encoding_name(candidate)) {
+                encoding = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t encoded_length(Encoding encoding, std::size_t bytes) {
+        switch (encoding) {
+        case Encoding::Hex:       return bytes * 2;
+        case Encoding::Base64Url: return (bytes * 4 + 2) / 3;
+        case Encoding::Base32:    return (bytes * 8 + 4) / 5;
+        }
+        return 0;
+    }
+
+    // Längen, die keine Kodierung erzeugt (ein einzelnes Zeichen trägt kein ganzes Byte)
+    static bool valid_length(Encoding encoding, std::size_t chars) {
+        switch (encoding) {
+        case Encoding::Hex:       return chars % 2 == 0;
+        case Encoding::Base64Url: return chars % 4 != 1;
+        case Encoding::Base32:    return chars % 8 != 1 && chars % 8 != 3 && chars % 8 != 6;
+        }
+        return false;
+    }
+
+    std::size_t decoded_length(Encoding encoding, std::size_t chars) {
+        if (!valid_length(encoding, chars))
+            return 0;
+        switch (encoding) {
+        case Encoding::Hex:       return chars / 2;
+        case Encoding::Base64Url: return chars * 3 / 4;
+        case Encoding::Base32:    return chars * 5 / 8;
+        }
+        return 0;
+    }
+
+    std::size_t encode_into(std::span<char> out, std::span<const std::byte> bytes, Encoding encoding) {
+        const std::size_t length = encoded_length(encoding, bytes.size());
+        if (out.size() < length)
+            return 0;
+        activeKernels.load(std::memory_order_acquire)->encode[static_cast<int>(encoding)](reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size(), out.data());
+        return length;
+    }
+
+    std::string encode(std::span<const std::byte> bytes, Encoding encoding) {
+        std::string out(encoded_length(encoding, bytes.size()), '\0');
+        encode_into(out, bytes, encoding);
+        return out;
+    }
+
+    std::pmr::string encode(std::span<const std::byte> bytes, Encoding encoding, std::pmr::memory_resource* resource) {
+        std::pmr::string out(encoded_length(encoding, bytes.size()), '\0', resource);
+        encode_into(out, bytes, encoding);
+        return out;
+    }
+
+    std::size_t decode_into(std::span<std::byte> out, std::string_view text, Encoding encoding) {
+        if (!valid_length(encoding, text.size()))
+            return 0;
+        const std::size_t length = decoded_length(encoding, text.size());
+        if (out.size() < length)
+            return 0;
+        if (!activeKernels.load(std::memory_order_acquire)->decode[static_cast<int>(encoding)](text.data(), text.size(), reinterpret_cast<uint8_t*>(out.data())))
+            return 0;
+        return length;
+    }
+
+    std::vector<std::byte> decode(std::string_view text, Encoding encoding) {
+        std::vector<std::byte> out(decoded_length(encoding, text.size()));
+        if (out.empty() || decode_into(out, text, encoding) != out.size())
+            return {};
+        return out;
+    }
+}
@@ -0,0 +1,484 @@
+#include "../include/crono_entropy.h"
+#include "../include/crono_drbg.h"
+#include "../include/crono_utils.h"
+#include "../include/crono_ring.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <oqs/oqs.h>  // OQS_randombytes, OQS_randombytes_custom_algorithm
+
+namespace CronoEntropy {
+
+    // --- Hintergrund-Sammler ---
+
+    // Index der Ringe im Sammler
+    enum HarvestSource : std::size_t {
+        HARVEST_RAM,
+        HARVEST_CACHE,
+        HARVEST_GHOST,
+        HARVEST_WALK,
+        HARVEST_SOURCES
+    };
+
+    static uint64_t compute_source(std::size_t source) {
+        switch (source) {
+        case HARVEST_RAM:   return CronoUtils::ram_fingerprint();
+        case HARVEST_CACHE: return CronoUtils::cache_noise();
+        case HARVEST_GHOST: return CronoUtils::ghost_salt();
+        default:            return CronoUtils::memory_walk();
+        }
+    }
+
+    class EntropyHarvester {
+    public:
+        explicit EntropyHarvester(const EntropyHarvesterOptions& options)
+            : rings_{ Ring(options.capacity), Ring(options.capacity), Ring(options.capacity), Ring(options.capacity) },
+              pid_(CronoUtils::current_pid()), started_ns_(CronoUtils::get_steady_time()) {
+            thread_ = std::thread([this]() { produce(); });
+        }
+
+        ~EntropyHarvester() {
+            running_.store(false);
+            // Wartenden Sammler wecken
+            space_.fetch_add(1);
+            space_.notify_all();
+            thread_.join();
+        }
+
+        // false: Ring leer oder von einem fork() geerbt – der Aufrufer rechnet selbst
+        bool take(std::size_t source, uint64_t& out) {
+            // Im Kindprozess läuft der Sammler nicht mehr, und die Werte gehören dem Elternprozess
+            if (CronoUtils::current_pid() != pid_)
+                return false;
+            if (!rings_[source].try_pop(out)) {
+                misses_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            space_.fetch_add(1);
+            space_.notify_one();
+            return true;
+        }
+
+        EntropyHarvesterStats stats() const {
+            EntropyHarvesterStats stats;
+            stats.running = running_.load();
+            for (const Ring& ring : rings_) {
+                stats.depth += ring.size_approx();
+            }
+            stats.capacity = rings_[0].capacity();
+            stats.produced = produced_.load(std::memory_order_relaxed);
+            stats.hits = hits_.load(std::memory_order_relaxed);
+            stats.misses = misses_.load(std::memory_order_relaxed);
+            const uint64_t elapsed_ns = CronoUtils::get_steady_time() - started_ns_;
+            if (elapsed_ns > 0)
+                stats.refill_per_second = static_cast<double>(stats.produced) * 1e9 / static_cast<double>(elapsed_ns);
+            return stats;
+        }
+
+    private:
+        using Ring = CronoUtils::MpmcRing<uint64_t>;
+
+        void produce() {
+            while (running_.load()) {
+                const uint64_t seen = space_.load();
+                // Reihum jede Quelle auffüllen, die noch Platz hat
+                bool pushed = false;
+                for (std::size_t source = 0; source < HARVEST_SOURCES && running_.load(); source++) {
+                    if (rings_[source].size_approx() >= rings_[source].capacity())
+                        continue;
+                    if (rings_[source].try_push(compute_source(source))) {
+                        produced_.fetch_add(1, std::memory_order_relaxed);
+                        pushed = true;
+                    }
+                }
+                // Alle Ringe voll: bis zur nächsten Entnahme schlafen
+                if (!pushed && running_.load())
+                    space_.wait(seen);
+            }
+        }
+
+        std::array<Ring, HARVEST_SOURCES> rings_;
+        const long pid_;
+        const uint64_t started_ns_;
+        std::thread thread_;
+        std::atomic<bool> running_{ true };
+        // Generationszähler für atomic::wait/notify, erhöht nach jeder Entnahme
+        std::atomic<uint64_t> space_{ 0 };
+        std::atomic<uint64_t> produced_{ 0 };
+        std::atomic<uint64_t> hits_{ 0 };
+        std::atomic<uint64_t> misses_{ 0 };
+    };
+
+    static std::mutex harvesterMutex;                  // Serialisiert start/stop
+    static std::atomic<bool> harvesterEnabled{ false }; // Schneller Test auf dem Anfragepfad
+    static std::atomic<std::shared_ptr<EntropyHarvester>> activeHarvester;
+
+    bool start_entropy_harvester(const EntropyHarvesterOptions& options) {
+        std::lock_guard<std::mutex> lock(harvesterMutex);
+        if (activeHarvester.load() != nullptr)
+            return false;
+        activeHarvester.store(std::make_shared<EntropyHarvester>(options));
+        harvesterEnabled.store(true);
+        return true;
+    }
+
+    void stop_entropy_harvester() {
+        std::shared_ptr<EntropyHarvester> harvester;
+        {
+            std::lock_guard<std::mutex> lock(harvesterMutex);
+            harvesterEnabled.store(false);
+            harvester = activeHarvester.exchange(nullptr);
+        }
+        // Laufende Entnahmen halten eigene Referenzen; der letzte Besitzer beendet den Sammler
+    }
+
+    EntropyHarvesterStats entropy_harvester_stats() {
+        std::shared_ptr<EntropyHarvester> harvester = activeHarvester.load();
+        return harvester ? harvester->stats() : EntropyHarvesterStats{};
+    }
+
+    // Vorab gesammelter Wert, sofern ein Sammler läuft und sein Ring nicht leer ist
+    static bool harvested(std::size_t source, uint64_t& out) {
+        if (!harvesterEnabled.load(std::memory_order_relaxed))
+            return false;
+        std::shared_ptr<EntropyHarvester> harvester = activeHarvester.load();
+        return harvester && harvester->take(source, out);
+    }
+
+    // --- Produktion ---
+
+    uint64_t ProductionClock::tsc() {
+        return CronoUtils::get_tsc();
+    }
+
+    uint64_t ProductionClock::nano() {
+#ifdef _WIN32
+        // Unter Windows: Nutze die implementierte Funktion
+        return CronoUtils::get_current_nanotime();
+#else
+        // Unter Linux (Debian/Ubuntu): Verwende system_clock für die reale Systemzeit
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    uint64_t ProductionClock::steady() {
+        // Steady Clock bleibt plattformunabhängig (monotonic)
+        return CronoUtils::get_steady_time();
+    }
+
+    void ProductionEntropy::random_bytes(uint8_t* out, std::size_t length) {
+        OQS_randombytes(out, length);
+    }
+
+    uint64_t ProductionEntropy::ram_fingerprint() {
+        uint64_t value;
+        if (harvested(HARVEST_RAM, value))
+            return value;
+        return CronoUtils::ram_fingerprint();
+    }
+
+    uint64_t ProductionEntropy::cache_noise() {
+        uint64_t value;
+        if (harvested(HARVEST_CACHE, value))
+            return value;
+        return CronoUtils::cache_noise();
+    }
+
+    uint64_t ProductionEntropy::ghost_salt() {
+        uint64_t value;
+        if (harvested(HARVEST_GHOST, value))
+            return value;
+        return CronoUtils::ghost_salt();
+    }
+
+    uint64_t ProductionEntropy::memory_walk() {
+        uint64_t value;
+        if (harvested(HARVEST_WALK, value))
+            return value;
+        return CronoUtils::memory_walk();
+    }
+
+    uint64_t ProductionEntropy::binding_factor(double duration_ms) {
+        return CronoUtils::adaptive_binding_factor(duration_ms);
+    }
+
+    ClockSource& production_clock() {
+        static ProductionClock clock;
+        return clock;
+    }
+
+    EntropyProvider& production_entropy() {
+        static ProductionEntropy entropy;
+        return entropy;
+    }
+
+    // --- Fest ---
+
+    FixedClock::FixedClock(uint64_t tsc, uint64_t nano, uint64_t steady, uint64_t step)
+        : tsc_(tsc), nano_(nano), steady_(steady), step_(step) {
+    }
+
+    uint64_t FixedClock::tsc() {
+        uint64_t value = tsc_;
+        tsc_ += step_;
+        return value;
+    }
+
+    uint64_t FixedClock::nano() {
+        uint64_t value = nano_;
+        nano_ += step_;
+        return value;
+    }
+
+    uint64_t FixedClock::steady() {
+        uint64_t value = steady_;
+        steady_ += step_;
+        return value;
+    }
+
+    FixedSeedEntropy::FixedSeedEntropy(uint64_t seed) : state_(seed) {
+    }
+
+    uint64_t FixedSeedEntropy::next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    void FixedSeedEntropy::random_bytes(uint8_t* out, std::size_t length) {
+        for (std::size_t i = 0; i < length; i += 8) {
+            const uint64_t word = next();
+            for (std::size_t b = 0; b < 8 && i + b < length; b++) {
+                out[i + b] = static_cast<uint8_t>(word >> (8 * b));
+            }
+        }
+    }
+
+    // --- Aufzeichnen und Wiedergeben ---
+
+    void Recording::push(uint64_t value) {
+        values_.push_back(value);
+    }
+
+    void Recording::push_bytes(const uint8_t* data, std::size_t length) {
+        bytes_.insert(bytes_.end(), data, data + length);
+    }
+
+    uint64_t Recording::next() {
+        if (value_pos_ >= values_.size()) {
+            exhausted_ = true;
+            return 0;
+        }
+        return values_[value_pos_++];
+    }
+
+    void Recording::next_bytes(uint8_t* out, std::size_t length) {
+        for (std::size_t i = 0; i < length; i++) {
+            if (byte_pos_ >= bytes_.size()) {
+                exhausted_ = true;
+                out[i] = 0;
+                continue;
+            }
+            out[i] = bytes_[byte_pos_++];
+        }
+    }
+
+    void Recording::rewind() {
+        value_pos_ = 0;
+        byte_pos_ = 0;
+        exhausted_ = false;
+    }
+
+    // Textformat: Kopfzeile, dann je Wert eine Zeile "v <hex>" und die Zufallsbytes als Hex-Zeilen "b <hex>"
+    static const char RECORDING_HEADER[] = "crono-recording 1";
+    static constexpr std::size_t BYTES_PER_LINE = 64;
+
+    std::string Recording::to_text() const {
+        static const char digits[] = "0123456789abcdef";
+        std::ostringstream out;
+        out << RECORDING_HEADER << "\n";
+        for (uint64_t value : values_) {
+            out << "v " << std::hex << value << std::dec << "\n";
+        }
+        for (std::size_t i = 0; i < bytes_.size(); i += BYTES_PER_LINE) {
+            out << "b ";
+            for (std::size_t j = i; j < i + BYTES_PER_LINE && j < bytes_.size(); j++) {
+                out << digits[bytes_[j] >> 4] << digits[bytes_[j] & 0x0F];
+            }
+            out << "\n";
+        }
+        return out.str();
+    }
+
+    static int hex_value(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool Recording::from_text(std::string_view text) {
+        Recording parsed;
+        bool header = false;
+        while (!text.empty()) {
+            const std::size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                continue;
+            if (!header) {
+                if (line != RECORDING_HEADER)
+                    return false;
+                header = true;
+                continue;
+            }
+            if (line.size() < 3 || line[1] != ' ')
+                return false;
+            const std::string_view payload = line.substr(2);
+            if (line[0] == 'v') {
+                if (payload.size() > 16)
+                    return false;
+                uint64_t value = 0;
+                for (char c : payload) {
+                    const int digit = hex_value(c);
+                    if (digit < 0)
+                        return false;
+                    value = (value << 4) | static_cast<uint64_t>(digit);
+                }
+                parsed.values_.push_back(value);
+            }
+            else if (line[0] == 'b') {
+                if (payload.size() % 2 != 0)
+                    return false;
+                for (std::size_t i = 0; i < payload.size(); i += 2) {
+                    const int hi = hex_value(payload[i]);
+                    const int lo = hex_value(payload[i + 1]);
+                    if (hi < 0 || lo < 0)
+                        return false;
+                    parsed.bytes_.push_back(static_cast<uint8_t>((hi << 4) | lo));
+                }
+            }
+            else {
+                return false;
+            }
+        }
+        if (!header)
+            return false;
+        *this = std::move(parsed);
+        return true;
+    }
+
+    uint64_t RecordingClock::tsc() {
+        uint64_t value = inner_.tsc();
+        recording_.push(value);
+        return value;
+    }
+
+    uint64_t RecordingClock::nano() {
+        uint64_t value = inner_.nano();
+        recording_.push(value);
+        return value;
+    }
+
+    uint64_t RecordingClock::steady() {
+        uint64_t value = inner_.steady();
+        recording_.push(value);
+        return value;
+    }
+
+    void RecordingEntropy::random_bytes(uint8_t* out, std::size_t length) {
+        inner_.random_bytes(out, length);
+        recording_.push_bytes(out, length);
+    }
+
+    uint64_t RecordingEntropy::ram_fingerprint() {
+        uint64_t value = inner_.ram_fingerprint();
+        recording_.push(value);
+        return value;
+    }
+
+    uint64_t RecordingEntropy::cache_noise() {
+        uint64_t value = inner_.cache_noise();
+        recording_.push(value);
+        return value;
+    }
+
+    uint64_t RecordingEntropy::ghost_salt() {
+        uint64_t value = inner_.ghost_salt();
+        recording_.push(value);
+        return value;
+    }
+
+    uint64_t RecordingEntropy::memory_walk() {
+        uint64_t value = inner_.memory_walk();
+        recording_.push(value);
+        return value;
+    }
+
+    uint64_t RecordingEntropy::binding_factor(double duration_ms) {
+        uint64_t value = inner_.binding_factor(duration_ms);
+        recording_.push(value);
+        return value;
+    }
+
+    // --- Umleitung von OQS_randombytes ---
+
+    static thread_local EntropyProvider* activeSource = nullptr;
+    static thread_local uint64_t sourceEpoch = 0;
+
+    static void dispatch_randombytes(uint8_t* out, std::size_t length) {
+        EntropyProvider* source = activeSource;
+        if (source == nullptr) {
+            drbg_random_bytes(out, length);
+            return;
+        }
+        // Verschachtelte OQS_randombytes-Aufrufe innerhalb der Quelle gehen an den DRBG des Threads
+        activeSource = nullptr;
+        source->random_bytes(out, length);
+        activeSource = source;
+    }
+
+    static bool install_dispatcher() {
+        static std::once_flag installed;
+        std::call_once(installed, []() { OQS_randombytes_custom_algorithm(&dispatch_randombytes); });
+        return true;
+    }
+
+    // Beim Laden registrieren, damit auch Aufrufe ohne vorherige Umleitung (Schlüsselerzeugung, Kapselung)
+    // aus dem DRBG statt per Systemaufruf bedient werden
+    [[maybe_unused]] static const bool dispatcherInstalled = install_dispatcher();
+
+    ScopedRandomSource::ScopedRandomSource(EntropyProvider& provider) {
+        if (provider.is_production())
+            return;
+        install_dispatcher();
+        previous_ = activeSource;
+        activeSource = &provider;
+        active_ = true;
+        sourceEpoch++;
+    }
+
+    ScopedRandomSource::~ScopedRandomSource() {
+        if (active_) {
+            activeSource = previous_;
+            sourceEpoch++;
+        }
+    }
+
+    uint64_t random_source_epoch() {
+        return sourceEpoch;
+    }
+
+    bool random_source_active() {
+        return activeSource != nullptr;
+    }
+}
@@ -0,0 +1,239 @@
+#include "../include/crono_file.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CronoHash {
+
+    using Clock = std::chrono::steady_clock;
+
+    static double elapsed_ms(Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+    }
+
+    static uint64_t major_faults() {
+#ifdef _WIN32
+        return 0;
+#else
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<uint64_t>(usage.ru_majflt);
+#endif
+    }
+
+    // --- Lesepfad ---
+
+    bool absorb_file_stream(Stream& stream, std::FILE* file, FileHashStats* stats) {
+        // Zwei Puffer: der Leser füllt einen, während der Aufrufer den anderen hasht
+        const std::size_t BUFFER_BYTES = 1 << 20;
+        struct Slot {
+            std::vector<std::byte> data;
+            std::size_t size = 0;
+            bool full = false;
+        };
+        Slot slots[2];
+        for (Slot& slot : slots) {
+            slot.data.resize(BUFFER_BYTES);
+        }
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool failed = false;
+
+        const auto start = Clock::now();
+        const uint64_t faults = major_faults();
+        std::thread reader([&]() {
+            for (std::size_t i = 0;; i ^= 1) {
+                Slot& slot = slots[i];
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]() { return !slot.full; });
+                }
+                // fread() kehrt erst mit vollem Puffer oder am Ende der Eingabe zurück
+                const std::size_t n = std::fread(slot.data.data(), 1, slot.data.size(), file);
+                const bool error = n < slot.data.size() && std::ferror(file);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slot.size = n;
+                    slot.full = true;
+                    failed = error;
+                }
+                changed.notify_all();
+                // Ein nicht voller Puffer ist der letzte; ein leerer markiert das Ende
+                if (n < slot.data.size())
+                    return;
+            }
+            });
+
+        FileHashStats local;
+        for (std::size_t i = 0;; i ^= 1) {
+            Slot& slot = slots[i];
+            const auto waiting = Clock::now();
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return slot.full; });
+            }
+            local.wait_ms += elapsed_ms(waiting);
+            const std::size_t n = slot.size;
+            if (n > 0) {
+                const auto hashing = Clock::now();
+                stream.update(std::span<const std::byte>(slot.data.data(), n));
+                local.hash_ms += elapsed_ms(hashing);
+                local.bytes += n;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                slot.full = false;
+            }
+            changed.notify_all();
+            if (n < slot.data.size())
+                break;
+        }
+        reader.join();
+
+        local.total_ms = elapsed_ms(start);
+        local.major_faults = major_faults() - faults;
+        if (stats != nullptr)
+            *stats = local;
+        return !failed;
+    }
+
+    // --- Gemappter Pfad ---
+
+    // Absorbiert eine gemappte Datei; Blöcke statt eines einzigen update(), damit hash_ms und die
+    // Seitenfehler auch bei sehr großen Dateien gleichmäßig erfasst werden
+    static void absorb_mapped(Stream& stream, const std::byte* data, uint64_t size, FileHashStats& stats) {
+        const uint64_t CHUNK_BYTES = 8 << 20;
+        for (uint64_t offset = 0; offset < size; offset += CHUNK_BYTES) {
+            const std::size_t n = static_cast<std::size_t>(size - offset < CHUNK_BYTES ? size - offset : CHUNK_BYTES);
+            const auto hashing = Clock::now();
+            stream.update(std::span<const std::byte>(data + offset, n));
+            stats.hash_ms += elapsed_ms(hashing);
+            stats.bytes += n;
+        }
+    }
+
+#ifdef _WIN32
+
+    // Gemappt absorbieren; false ohne Seiteneffekte auf stream, wenn sich die Datei nicht mappen lässt
+    static bool absorb_mapped_file(Stream& stream, HANDLE file, FileHashStats& stats) {
+        LARGE_INTEGER size{};
+        // Leere Dateien lassen sich nicht mappen; der Lesepfad liefert für sie dasselbe Ergebnis
+        if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size) || size.QuadPart == 0 ||
+            static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX)
+            return false;
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr) {
+            if (mapping != nullptr)
+                CloseHandle(mapping);
+            return false;
+        }
+        stats.mapped = true;
+        absorb_mapped(stream, static_cast<const std::byte*>(view), static_cast<uint64_t>(size.QuadPart), stats);
+        UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        return true;
+    }
+
+    bool absorb_file(Stream& stream, const char* path, FileHashStats* stats) {
+        if (std::strcmp(path, "-") == 0) {
+            _setmode(_fileno(stdin), _O_BINARY);
+            return absorb_file_stream(stream, stdin, stats);
+        }
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        FileHashStats local;
+        const auto start = Clock::now();
+        const bool mapped = absorb_mapped_file(stream, file, local);
+        CloseHandle(file);
+        if (mapped) {
+            local.total_ms = elapsed_ms(start);
+            if (stats != nullptr)
+                *stats = local;
+            return true;
+        }
+        std::FILE* input = std::fopen(path, "rb");
+        if (input == nullptr)
+            return false;
+        const bool ok = absorb_file_stream(stream, input, stats);
+        std::fclose(input);
+        return ok;
+    }
+
+#else
+
+    // Bildet den Rest der Datei ab der aktuellen Position ab (bei stdin kann ein Vorgänger bereits gelesen haben)
+    // und setzt die Position danach wie ein Lesen ans Dateiende
+    static bool absorb_mapped_file(Stream& stream, int fd, FileHashStats& stats) {
+        struct stat info {};
+        // Größe 0 auch bei Pseudodateien wie /proc/*, deren Inhalt erst beim Lesen entsteht: Lesepfad
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0 ||
+            static_cast<uint64_t>(info.st_size) > SIZE_MAX)
+            return false;
+        const off_t position = lseek(fd, 0, SEEK_CUR);
+        if (position < 0 || position >= info.st_size)
+            return false;
+        // mmap verlangt einen Offset auf Seitengrenze; der Rest davor wird übersprungen
+        const off_t page = static_cast<off_t>(sysconf(_SC_PAGESIZE));
+        const off_t aligned = position - position % page;
+        const std::size_t length = static_cast<std::size_t>(info.st_size - aligned);
+        void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, aligned);
+        if (view == MAP_FAILED)
+            return false;
+        stats.mapped = true;
+        // Aggressives Vorauslesen; bereits gehashte Seiten darf der Kernel früh verdrängen
+        madvise(view, length, MADV_SEQUENTIAL);
+        absorb_mapped(stream, static_cast<const std::byte*>(view) + (position - aligned), static_cast<uint64_t>(info.st_size - position), stats);
+        munmap(view, length);
+        lseek(fd, info.st_size, SEEK_SET);
+        return true;
+    }
+
+    bool absorb_file(Stream& stream, const char* path, FileHashStats* stats) {
+        const bool from_stdin = std::strcmp(path, "-") == 0;
+        // Auch stdin wird gemappt, wenn es auf eine reguläre Datei umgeleitet ist
+        const int fd = from_stdin ? STDIN_FILENO : open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+        FileHashStats local;
+        const auto start = Clock::now();
+        const uint64_t faults = major_faults();
+        if (absorb_mapped_file(stream, fd, local)) {
+            local.total_ms = elapsed_ms(start);
+            local.major_faults = major_faults() - faults;
+            if (!from_stdin)
+                close(fd);
+            if (stats != nullptr)
+                *stats = local;
+            return true;
+        }
+        if (from_stdin)
+            return absorb_file_stream(stream, stdin, stats);
+        std::FILE* input = fdopen(fd, "rb");
+        if (input == nullptr) {
+            close(fd);
+            return false;
+        }
+        const bool ok = absorb_file_stream(stream, input, stats);
+        std::fclose(input);
+        return ok;
+    }
+
+#endif
+}
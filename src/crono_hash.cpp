@@ -2,12 +2,18 @@
 #include "../include/crono_utils.h"
 #include "../include/crono_math.h"
 #include "../include/crono_quantum.h"
-#include <sstream>
-#include <iomanip>
+#include "../include/crono_entropy.h"
+#include "../include/crono_arena.h"
+#include "../include/crono_pool.h"
 #include <vector>
+#include <array>
+#include <charconv>
 #include <chrono>  // Für alternative Zeitquellen
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
-static std::string modeToString(CronoHash::CronoMode mode) {
+static const char* modeToString(CronoHash::CronoMode mode) {
     using CronoMode = CronoHash::CronoMode;
     switch (mode) {
     case CronoMode::FAST:      return "FAST";
@@ -20,61 +26,158 @@ static std::string modeToString(CronoHash::CronoMode mode) {
 
 namespace CronoHash {
 
-    std::string hash(const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+    // Vorab erhobene Umgebungsentropie, die ein Hasher über mehrere Aufrufe hinweg wiederverwendet,
+    // und die Quellen für alle Werte, die erst während der Pipeline gelesen werden
+    struct Environment {
+        uint64_t ram;
+        uint64_t cache;
+        uint64_t ghost;
+        CronoEntropy::ClockSource* clock;
+        CronoEntropy::EntropyProvider* entropy;
+    };
+
+    static unsigned int word_count(unsigned int bit_strength) {
         // Berechne die Anzahl der 64-Bit-Worte, die benötigt werden:
         unsigned int num_words = bit_strength / 64;
         if (num_words == 0)
             num_words = 1; // Sicherheitshalber
+        return num_words;
+    }
+
+    // Hält kleine Puffer (bis 2048 Bit) auf dem Stack und weicht nur für größere Bitstärken auf die
+    // Scratch-Ressource des Threads aus (CronoUtils::scratch_resource, standardmäßig die Thread-Arena)
+    template <typename T, std::size_t N>
+    class ScratchBuffer {
+    public:
+        explicit ScratchBuffer(std::size_t n) : heap_(CronoUtils::scratch_resource()), size_(n) {
+            if (n > N)
+                heap_.resize(n);
+        }
+        T* data() { return size_ > N ? heap_.data() : fixed_.data(); }
+        std::size_t size() const { return size_; }
+
+    private:
+        std::array<T, N> fixed_;
+        std::pmr::vector<T> heap_;
+        std::size_t size_;
+    };
+
+    // Größte Wortanzahl der Dispatch-Tabelle (2048 Bit)
+    static constexpr std::size_t MAX_TABLE_WORDS = 2048 / 64;
+    using WordBuffer = ScratchBuffer<uint64_t, MAX_TABLE_WORDS>;
+
+    // Schreibt die Worte Big-Endian, damit die Byte-Reihenfolge der Hex-Ausgabe entspricht
+    static void store_words(std::span<std::byte> out, const uint64_t* words, std::size_t num_words) {
+        for (std::size_t i = 0; i < num_words; i++) {
+            for (std::size_t b = 0; b < 8; b++) {
+                out[i * 8 + b] = static_cast<std::byte>(words[i] >> (56 - 8 * b));
+            }
+        }
+    }
+
+    // Größe des SHAKE128-Auszugs, den die Quantum-Runden in V2 statt der vollständigen Eingabe sehen
+    static constexpr std::size_t SPONGE_SUMMARY_BYTES = 64;
+    // Auszug und Lane-Bytes der größten Tabellen-Bitstärke
+    static constexpr std::size_t MAX_TABLE_SQUEEZE = SPONGE_SUMMARY_BYTES + MAX_TABLE_WORDS * 8;
+
+    // Die tatsächlich in den Hash eingeflossenen Zeit- und Bindungswerte eines Durchlaufs
+    struct PipelineTrace {
+        uint64_t tsc = 0;
+        uint64_t nano = 0;
+        uint64_t steady = 0;
+        uint64_t binding_factor = 0;
+    };
 
-        // Array zur Speicherung – hier verwenden wir einen Vektor
-        std::vector<uint64_t> words(num_words);
+    // Einmal pro Batch vorbereitete Ressourcen, die sonst jeder Aufruf selbst anlegt
+    struct SharedSetup {
+        uint64_t binding_factor = 0;   // Bereits berechneter Bindungsfaktor (nur bei binding_duration_ms > 0)
+    };
+
+    // Welche Bytes die datenabhängigen Runden sehen.
+    // V1: jede Runde liest die vollständige Eingabe.
+    // V2: die Eingabe wurde einmal in einen SHAKE128-Sponge absorbiert; jedes Wort erhält daraus
+    //     8 eigene Lane-Bytes, die Quantum-Runden einen gemeinsamen 64-Byte-Auszug.
+    // V3: wie V2 für die Lane-Bytes; die Quantum-Runden klonen den absorbierten Zustand pro Wort
+    //     und sehen so die vollständige Eingabe, ohne sie erneut zu lesen.
+    struct PipelineInput {
+        const char* data = nullptr;
+        std::size_t length = 0;
+        const char* lane_bytes = nullptr;   // V2/V3: num_words * 8 Bytes
+        const char* summary = nullptr;      // V2: SPONGE_SUMMARY_BYTES Bytes
+        const CronoQuantum::AbsorbedInput* absorbed = nullptr;  // V3
+
+        const char* mix_data(unsigned int i) const { return lane_bytes ? lane_bytes + 8 * i : data; }
+        std::size_t mix_length() const { return lane_bytes ? 8 : length; }
+        const char* quantum_data() const { return summary ? summary : data; }
+        std::size_t quantum_length() const { return summary ? SPONGE_SUMMARY_BYTES : length; }
+    };
+
+    static void encode_length(std::uint64_t absorbed, uint8_t* length_block) {
+        for (std::size_t i = 0; i < 8; i++) {
+            length_block[i] = static_cast<uint8_t>(absorbed >> (8 * i));
+        }
+    }
+
+    // Sponge-Zustand für hash_with_environment (V2/V3); pro Thread einmal angelegt, damit wiederholte Aufrufe
+    // weder den Zustand noch die liboqs-Kontexte neu allokieren
+    static CronoQuantum::AbsorbedInput& thread_sponge() {
+        static thread_local CronoQuantum::AbsorbedInput sponge;
+        return sponge;
+    }
+
+    // Wort-Pipeline, zur Compile-Zeit spezialisiert auf Modus M und Wortanzahl N.
+    // Bei N > 0 haben alle Schleifen feste Trip-Counts (der Compiler rollt sie aus), für N = 0 wird die
+    // Wortanzahl erst zur Laufzeit übergeben. Im Modus deaktivierte Stufen entfallen per if constexpr.
+    template <CronoMode M, unsigned int N>
+    static void pipeline_kernel(uint64_t* words, unsigned int runtime_words, const PipelineInput& input, double binding_duration_ms, const Environment& env, PipelineTrace& trace, const SharedSetup* shared) {
+        const unsigned int num_words = N > 0 ? N : runtime_words;
 
         // Zeit- und Entropiequellen:
-        uint64_t tsc = CronoUtils::get_tsc();
-#ifdef _WIN32
-        // Unter Windows: Nutze die implementierte Funktion
-        uint64_t nano = CronoUtils::get_current_nanotime();
-#else
-        // Unter Linux (Debian/Ubuntu): Verwende system_clock für die reale Systemzeit
-        uint64_t nano = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-#endif
-        // Steady Clock bleibt plattformunabhängig (monotonic)
-        uint64_t steady = CronoUtils::get_steady_time();
-
-        // Erzeuge Umgebungsentropie
-        uint64_t ram = CronoUtils::ram_fingerprint();
-        uint64_t cache = CronoUtils::cache_noise();
+        uint64_t tsc = env.clock->tsc();
+        uint64_t nano = env.clock->nano();
+        uint64_t steady = env.clock->steady();
+        trace.tsc = tsc;
+        trace.nano = nano;
+        trace.steady = steady;
+
+        // Umgebungsentropie stammt aus dem Hasher-Kontext
+        uint64_t ram = env.ram;
+        uint64_t cache = env.cache;
+
+        // Die Worte sind innerhalb einer Runde unabhängig voneinander: Jede Stufe läuft über alle Worte,
+        // damit die vektorisierten CronoMath-Kernel mehrere Worte pro Instruktion verarbeiten.
 
         // Initialisierungsrunde: Jeder 64-Bit Block erhält einen Startwert,
         // der aus den Zeit- und Entropiequellen sowie einer Primzahl abgeleitet wird.
         for (unsigned int i = 0; i < num_words; i++) {
             words[i] = tsc ^ (nano << ((i % 8) + 1)) ^ steady ^ ram ^ cache ^ CronoMath::PRIMES[i % CronoMath::NUM_PRIMES];
-            words[i] = CronoUtils::mix_entropy(words[i], data, length);
-            words[i] = CronoMath::endomorph_transform(words[i], tsc);
-            words[i] = CronoMath::hash_const_mix(words[i]);
+            words[i] = CronoUtils::mix_entropy(words[i], input.mix_data(i), input.mix_length());
+        }
+        CronoMath::endomorph_transform_words(words, num_words, tsc);
+        CronoMath::hash_const_mix_words(words, num_words);
+        for (unsigned int i = 0; i < num_words; i++) {
             words[i] = CronoMath::mod_prime(words[i]);
         }
 
         // Zweite Mischrunde: Weitere Transformationen unter Einbeziehung von 'nano'
+        CronoMath::endomorph_transform_words(words, num_words, nano);
         for (unsigned int i = 0; i < num_words; i++) {
-            words[i] = CronoMath::endomorph_transform(words[i], nano);
-            words[i] = CronoUtils::mix_entropy(words[i], data, length);
-            words[i] = CronoMath::hash_const_mix(words[i]);
-            words[i] = CronoMath::mod_prime256(words[i], i % 4);
+            words[i] = CronoUtils::mix_entropy(words[i], input.mix_data(i), input.mix_length());
         }
+        CronoMath::hash_const_mix_words(words, num_words);
+        CronoMath::mod_prime256_words(words, num_words);
 
         // Zusätzliche Runden für SECURE/ENTROPIC-Modus
-        if (mode == CronoMode::SECURE || mode == CronoMode::ENTROPIC) {
+        if constexpr (M == CronoMode::SECURE || M == CronoMode::ENTROPIC) {
+            CronoMath::endomorph_transform_words(words, num_words, steady);
             for (unsigned int i = 0; i < num_words; i++) {
-                words[i] = CronoMath::endomorph_transform(words[i], steady);
-                words[i] = CronoUtils::mix_entropy(words[i], data, length);
+                words[i] = CronoUtils::mix_entropy(words[i], input.mix_data(i), input.mix_length());
             }
         }
 
         // Im ENTROPIC-Modus: Zusätzlicher Memory Walk
-        if (mode == CronoMode::ENTROPIC) {
-            uint64_t mem_walk = CronoUtils::memory_walk();
+        if constexpr (M == CronoMode::ENTROPIC) {
+            uint64_t mem_walk = env.entropy->memory_walk();
             for (unsigned int i = 0; i < num_words; i++) {
                 words[i] ^= mem_walk;
             }
@@ -82,60 +185,480 @@ namespace CronoHash {
 
         // Adaptive Zeitbindung (Temp Binding)
         if (binding_duration_ms > 0.0) {
-            uint64_t binding_factor = CronoUtils::adaptive_binding_factor(binding_duration_ms);
+            uint64_t binding_factor = shared ? shared->binding_factor : env.entropy->binding_factor(binding_duration_ms);
+            trace.binding_factor = binding_factor;
             for (unsigned int i = 0; i < num_words; i++) {
                 words[i] ^= binding_factor;
             }
         }
 
         // GhostSalt-Runde zur weiteren Vermischung
-        uint64_t gs = CronoUtils::ghost_salt();
+        uint64_t gs = env.ghost;
         for (unsigned int i = 0; i < num_words; i++) {
             words[i] ^= gs;
         }
 
         // Quantum Runden:
-        // Erste Runde via SHAKE128
-        for (unsigned int i = 0; i < num_words; i++) {
-            uint64_t qm = CronoQuantum::quantum_mix(words[i], data, length);
-            words[i] ^= qm;
+        // Erste Runde via SHAKE128 (V3: Klon des absorbierten Zustands, sonst vier Worte je Keccak-x4-Aufruf)
+        if (input.absorbed)
+            CronoQuantum::quantum_mix_words(words, num_words, *input.absorbed);
+        else
+            CronoQuantum::quantum_mix_words(words, num_words, input.quantum_data(), input.quantum_length());
+        // Zweite Runde via Kyber512 (Zufallsbytes von liboqs stammen aus der Entropiequelle)
+        CronoEntropy::ScopedRandomSource random_source(*env.entropy);
+        if (input.absorbed) {
+            CronoQuantum::quantum_mix_kyber_words(words, num_words, *input.absorbed);
         }
-        // Zweite Runde via Kyber512
-        for (unsigned int i = 0; i < num_words; i++) {
-            uint64_t qm2 = CronoQuantum::quantum_mix_kyber(words[i], data, length);
-            words[i] ^= qm2;
+        else {
+            for (unsigned int i = 0; i < num_words; i++) {
+                uint64_t qm2 = CronoQuantum::quantum_mix_kyber(words[i], input.quantum_data(), input.quantum_length());
+                words[i] ^= qm2;
+            }
+        }
+    }
+
+    using PipelineFn = void (*)(uint64_t*, unsigned int, const PipelineInput&, double, const Environment&, PipelineTrace&, const SharedSetup*);
+
+    template <CronoMode M>
+    static constexpr std::array<PipelineFn, 5> pipeline_row() {
+        return { &pipeline_kernel<M, 2>, &pipeline_kernel<M, 4>, &pipeline_kernel<M, 8>, &pipeline_kernel<M, 16>, &pipeline_kernel<M, 32> };
+    }
+
+    // Dispatch-Tabelle: 4 Modi (Index = CronoMode) × 5 Bitstärken (128, 256, 512, 1024, 2048)
+    static constexpr std::array<std::array<PipelineFn, 5>, 4> PIPELINE_TABLE = {
+        pipeline_row<CronoMode::FAST>(),
+        pipeline_row<CronoMode::BALANCED>(),
+        pipeline_row<CronoMode::SECURE>(),
+        pipeline_row<CronoMode::ENTROPIC>()
+    };
+
+    static std::atomic<bool> forceRuntimePipeline{ false };
+
+    void force_runtime_pipeline(bool enabled) {
+        forceRuntimePipeline.store(enabled, std::memory_order_relaxed);
+    }
+
+    static PipelineFn select_pipeline(CronoMode mode, unsigned int bit_strength) {
+        std::size_t m = static_cast<std::size_t>(mode);
+        if (m >= PIPELINE_TABLE.size())
+            m = static_cast<std::size_t>(CronoMode::BALANCED);
+        if (forceRuntimePipeline.load(std::memory_order_relaxed))
+            bit_strength = 0;
+        switch (bit_strength) {
+        case 128:  return PIPELINE_TABLE[m][0];
+        case 256:  return PIPELINE_TABLE[m][1];
+        case 512:  return PIPELINE_TABLE[m][2];
+        case 1024: return PIPELINE_TABLE[m][3];
+        case 2048: return PIPELINE_TABLE[m][4];
+        }
+        // Nicht tabellierte Bitstärken: Wortanzahl zur Laufzeit
+        switch (static_cast<CronoMode>(m)) {
+        case CronoMode::FAST:     return &pipeline_kernel<CronoMode::FAST, 0>;
+        case CronoMode::SECURE:   return &pipeline_kernel<CronoMode::SECURE, 0>;
+        case CronoMode::ENTROPIC: return &pipeline_kernel<CronoMode::ENTROPIC, 0>;
+        default:                  return &pipeline_kernel<CronoMode::BALANCED, 0>;
+        }
+    }
+
+    // Berechnet word_count(bit_strength) Worte nach words
+    static void run_pipeline(uint64_t* words, const PipelineInput& input, double binding_duration_ms, CronoMode mode, unsigned int bit_strength, const Environment& env, PipelineTrace& trace, const SharedSetup* shared) {
+        select_pipeline(mode, bit_strength)(words, word_count(bit_strength), input, binding_duration_ms, env, trace, shared);
+    }
+
+    // V3: Lane-Bytes aus SHAKE128(Eingabe || Länge), Quantum-Runden direkt aus dem absorbierten Zustand
+    static void run_absorbed_pipeline(uint64_t* words, const CronoQuantum::AbsorbedInput& absorbed, double binding_duration_ms, CronoMode mode, unsigned int bit_strength, const Environment& env, PipelineTrace& trace, const SharedSetup* shared) {
+        const std::size_t lane_length = static_cast<std::size_t>(word_count(bit_strength)) * 8;
+        ScratchBuffer<char, MAX_TABLE_WORDS * 8> lanes(lane_length);
+        uint8_t length_block[8];
+        encode_length(absorbed.absorbed(), length_block);
+        absorbed.derive(length_block, sizeof(length_block), reinterpret_cast<uint8_t*>(lanes.data()), lane_length);
+
+        PipelineInput input;
+        input.lane_bytes = lanes.data();
+        input.absorbed = &absorbed;
+        run_pipeline(words, input, binding_duration_ms, mode, bit_strength, env, trace, shared);
+    }
+
+    static void hash_with_environment(uint64_t* words, const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength, CronoVersion version, const Environment& env, PipelineTrace& trace, const SharedSetup* shared = nullptr) {
+        PipelineInput input;
+        if (version == CronoVersion::V1) {
+            input.data = data;
+            input.length = length;
+            run_pipeline(words, input, binding_duration_ms, mode, bit_strength, env, trace, shared);
+            return;
         }
 
+        CronoQuantum::AbsorbedInput& absorbed = thread_sponge();
+        absorbed.reset();
+        absorbed.absorb(data, length);
+        if (version == CronoVersion::V3) {
+            run_absorbed_pipeline(words, absorbed, binding_duration_ms, mode, bit_strength, env, trace, shared);
+            return;
+        }
+
+        // V2: ein einziger Durchlauf über die Eingabe; SHAKE128(Eingabe || Länge) liefert erst den Auszug,
+        // dann die Lane-Bytes. Die Eingabelänge wird mit absorbiert, damit Präfixe verschiedener Länge nicht kollidieren
+        const std::size_t lane_length = static_cast<std::size_t>(word_count(bit_strength)) * 8;
+        ScratchBuffer<char, MAX_TABLE_SQUEEZE> squeezed(SPONGE_SUMMARY_BYTES + lane_length);
+        uint8_t length_block[8];
+        encode_length(length, length_block);
+        absorbed.derive(length_block, sizeof(length_block), reinterpret_cast<uint8_t*>(squeezed.data()), squeezed.size());
+
+        input.summary = squeezed.data();
+        input.lane_bytes = squeezed.data() + SPONGE_SUMMARY_BYTES;
+        run_pipeline(words, input, binding_duration_ms, mode, bit_strength, env, trace, shared);
+    }
+
+    static Environment gather_environment(CronoEntropy::ClockSource& clock, CronoEntropy::EntropyProvider& entropy) {
+        const uint64_t ram = entropy.ram_fingerprint();
+        const uint64_t cache = entropy.cache_noise();
+        const uint64_t ghost = entropy.ghost_salt();
+        return Environment{ ram, cache, ghost, &clock, &entropy };
+    }
+
+    // Überträgt Zeit- und Bindungswerte sowie die Parameter eines Durchlaufs in result (ohne den Digest)
+    static void describe_result(HashResult& result, const PipelineTrace& trace, CronoMode mode, unsigned int bit_strength, CronoVersion version) {
+        result.tsc = trace.tsc;
+        result.nano = trace.nano;
+        result.steady = trace.steady;
+        result.binding_factor = trace.binding_factor;
+        result.mode = mode;
+        result.bit_strength = bit_strength;
+        result.version = version;
+    }
+
+    static HashResult make_result(const uint64_t* words, const PipelineTrace& trace, CronoMode mode, unsigned int bit_strength, CronoVersion version) {
+        HashResult result;
+        result.digest.resize(digest_size(bit_strength));
+        store_words(result.digest, words, word_count(bit_strength));
+        describe_result(result, trace, mode, bit_strength, version);
+        return result;
+    }
+
+    static void write_hex(std::span<const std::byte> bytes, char* out) {
+        encode_into(std::span<char>(out, bytes.size() * 2), bytes, Encoding::Hex);
+    }
+
+    std::string to_hex(std::span<const std::byte> bytes) {
+        std::string out(bytes.size() * 2, '0');
+        write_hex(bytes, out.data());
+        return out;
+    }
+
+    std::pmr::string to_hex(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) {
+        std::pmr::string out(bytes.size() * 2, '0', resource);
+        write_hex(bytes, out.data());
+        return out;
+    }
+
+    std::size_t digest_size(unsigned int bit_strength) {
+        return static_cast<std::size_t>(word_count(bit_strength)) * 8;
+    }
+
+    Hasher::Hasher(RefreshPolicy policy, CronoVersion version, CronoEntropy::Sources sources, std::pmr::memory_resource* scratch)
+        : policy_(policy), version_(version),
+          clock_(sources.clock ? sources.clock : &CronoEntropy::production_clock()),
+          entropy_(sources.entropy ? sources.entropy : &CronoEntropy::production_entropy()),
+          scratch_(scratch) {
+        refresh();
+    }
+
+    void Hasher::refresh() {
+        const Environment env = gather_environment(*clock_, *entropy_);
+        ram_ = env.ram;
+        cache_ = env.cache;
+        ghost_ = env.ghost;
+        hashes_since_refresh_ = 0;
+        refreshed_at_ns_ = clock_->steady();
+        pid_ = CronoUtils::current_pid();
+    }
+
+    void Hasher::refresh_if_due() {
+        if (policy_.on_fork && CronoUtils::current_pid() != pid_) {
+            refresh();
+            return;
+        }
+        if (policy_.every_n_hashes > 0 && hashes_since_refresh_ >= policy_.every_n_hashes) {
+            refresh();
+            return;
+        }
+        if (policy_.every_us > 0 && (clock_->steady() - refreshed_at_ns_) / 1000 >= policy_.every_us) {
+            refresh();
+        }
+    }
+
+    std::size_t Hasher::hash_into(std::span<std::byte> out, const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+        const std::size_t size = digest_size(bit_strength);
+        if (out.size() < size)
+            return 0;
+        refresh_if_due();
+        hashes_since_refresh_++;
+        CronoUtils::ScopedScratch scratch(scratch_);
+        PipelineTrace trace;
+        WordBuffer words(word_count(bit_strength));
+        hash_with_environment(words.data(), data, length, binding_duration_ms, mode, bit_strength, version_, Environment{ ram_, cache_, ghost_, clock_, entropy_ }, trace);
+        store_words(out, words.data(), words.size());
+        return size;
+    }
+
+    HashResult Hasher::hash_with_result(const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+        refresh_if_due();
+        hashes_since_refresh_++;
+        CronoUtils::ScopedScratch scratch(scratch_);
+        PipelineTrace trace;
+        WordBuffer words(word_count(bit_strength));
+        hash_with_environment(words.data(), data, length, binding_duration_ms, mode, bit_strength, version_, Environment{ ram_, cache_, ghost_, clock_, entropy_ }, trace);
+        return make_result(words.data(), trace, mode, bit_strength, version_);
+    }
+
+    std::size_t Hasher::hash_batch(std::span<const std::string_view> inputs, std::span<std::byte> out, const BatchOptions& options) {
+        const std::size_t size = digest_size(options.bit_strength);
+        if (out.size() < inputs.size() * size)
+            return 0;
+        if (inputs.empty())
+            return 0;
+
+        refresh_if_due();
+        hashes_since_refresh_ += inputs.size();
+        const Environment env{ ram_, cache_, ghost_, clock_, entropy_ };
+
+        // Zeitbindung einmal für den gesamten Batch
+        uint64_t binding_factor = 0;
+        if (options.binding_duration_ms > 0.0) {
+            binding_factor = entropy_->binding_factor(options.binding_duration_ms);
+        }
+
+        unsigned int num_threads = options.num_threads;
+        if (num_threads == 0)
+            num_threads = std::thread::hardware_concurrency();
+        if (num_threads == 0 || !entropy_->is_production())
+            num_threads = 1;  // Test-/Replay-Quellen sind nicht threadsicher
+        num_threads = static_cast<unsigned int>(std::min<std::size_t>(num_threads, inputs.size()));
+
+        // Kleine Blöcke per atomarem Zähler verteilen, damit ungleich lange Inputs ausbalanciert werden
+        const std::size_t chunk = 16;
+        std::atomic<std::size_t> next{ 0 };
+        auto worker = [&]() {
+            CronoUtils::ScopedScratch scratch(scratch_);
+            SharedSetup shared;
+            shared.binding_factor = binding_factor;
+            WordBuffer words(word_count(options.bit_strength));
+            while (true) {
+                const std::size_t begin = next.fetch_add(chunk);
+                if (begin >= inputs.size())
+                    break;
+                const std::size_t end = std::min(begin + chunk, inputs.size());
+                for (std::size_t i = begin; i < end; i++) {
+                    PipelineTrace trace;
+                    hash_with_environment(words.data(), inputs[i].data(), inputs[i].size(), options.binding_duration_ms, options.mode, options.bit_strength, version_, env, trace, &shared);
+                    store_words(out.subspan(i * size, size), words.data(), words.size());
+                }
+            }
+        };
+
+        // Worker aus dem persistenten Pool; der aufrufende Thread arbeitet mit
+        CronoUtils::WorkerPool::shared().parallel_for(num_threads, [&worker](std::size_t) { worker(); });
+        return inputs.size();
+    }
+
+    std::size_t hash_batch(std::span<const std::string_view> inputs, std::span<std::byte> out, const BatchOptions& options) {
+        Hasher hasher({}, CronoVersion::V1);
+        return hasher.hash_batch(inputs, out, options);
+    }
+
+    std::string Hasher::hash(const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
         // Ausgabe: Jeder 64-Bit Block wird als 16 Hexadezimalzeichen dargestellt
-        std::ostringstream out;
-        for (unsigned int i = 0; i < num_words; i++) {
-            out << std::hex << std::setw(16) << std::setfill('0') << words[i];
+        std::byte buffer[2048 / 8];
+        CronoUtils::ScopedScratch scratch(scratch_);
+        std::pmr::vector<std::byte> large(CronoUtils::scratch_resource());
+        std::span<std::byte> out(buffer);
+        if (digest_size(bit_strength) > sizeof(buffer)) {
+            large.resize(digest_size(bit_strength));
+            out = large;
         }
-        return out.str();
+        std::size_t written = hash_into(out, data, length, binding_duration_ms, mode, bit_strength);
+        return to_hex(out.first(written));
+    }
+
+    std::size_t hash_into(std::span<std::byte> out, const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+        // Rohe Bytes tragen keine Versionsangabe: V1 wie hash() (siehe CronoVersion)
+        Hasher hasher({}, CronoVersion::V1);
+        return hasher.hash_into(out, data, length, binding_duration_ms, mode, bit_strength);
+    }
+
+    std::string hash(const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+        // Dünner Wrapper: frische Umgebungsentropie für jeden einzelnen Aufruf. Der Hex-String trägt keine
+        // Versionsangabe, daher bleibt diese Funktion bei V1 (siehe CronoVersion).
+        Hasher hasher({}, CronoVersion::V1);
+        return hasher.hash(data, length, binding_duration_ms, mode, bit_strength);
+    }
+
+    HashResult hash_with_result(const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+        // Das Ergebnis führt die Version mit, daher die aktuelle Konstruktion
+        Hasher hasher({}, CronoVersion::V3);
+        return hasher.hash_with_result(data, length, binding_duration_ms, mode, bit_strength);
+    }
+
+    void hash_async(std::string data, std::function<void(HashResult)> done, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+        CronoUtils::WorkerPool::shared().submit([data = std::move(data), done = std::move(done), binding_duration_ms, mode, bit_strength]() {
+            done(hash_with_result(data.data(), data.size(), binding_duration_ms, mode, bit_strength));
+            });
+    }
+
+    std::future<HashResult> hash_async(std::string data, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
+        auto promise = std::make_shared<std::promise<HashResult>>();
+        std::future<HashResult> result = promise->get_future();
+        hash_async(std::move(data), [promise](HashResult r) { promise->set_value(std::move(r)); }, binding_duration_ms, mode, bit_strength);
+        return result;
+    }
+
+    std::string HashResult::hex() const {
+        return to_hex(digest);
+    }
+
+    std::string HashResult::encoded(Encoding encoding) const {
+        return encode(digest, encoding);
+    }
+
+    // Hängt value dezimal (base 10) oder hexadezimal (base 16, Kleinbuchstaben) an
+    template <typename String>
+    static void append_number(String& out, std::uint64_t value, int base = 10) {
+        char digits[20];
+        const auto end = std::to_chars(digits, digits + sizeof(digits), value, base).ptr;
+        out.append(digits, end);
+    }
+
+    // Baut das JSON ohne Stream direkt im Zielstring auf. compact schreibt alles in eine Zeile (JSON Lines);
+    // ein anderes Encoding als Hex wird im Feld "encoding" vermerkt.
+    template <typename String>
+    static void write_json(String& json, const HashResult& result, bool compact = false, Encoding encoding = Encoding::Hex) {
+        const char* separator = compact ? ", " : ",\n  ";
+        const std::size_t hash_length = encoded_length(encoding, result.digest.size());
+        json.reserve(json.size() + hash_length + 192);
+        json += compact ? "{\"hash\": \"" : "{\n  \"hash\": \"";
+        const std::size_t hash_at = json.size();
+        json.append(hash_length, '0');
+        encode_into(std::span<char>(json.data() + hash_at, hash_length), result.digest, encoding);
+        json += '"';
+        if (encoding != Encoding::Hex) {
+            json += separator;
+            json += "\"encoding\": \"";
+            json += encoding_name(encoding);
+            json += '"';
+        }
+        json += separator;
+        json += "\"tsc\": ";
+        append_number(json, result.tsc);
+        json += separator;
+        json += "\"nano\": ";
+        append_number(json, result.nano);
+        json += separator;
+        json += "\"steady\": ";
+        append_number(json, result.steady);
+        json += separator;
+        json += "\"binding_factor\": \"0x";
+        append_number(json, result.binding_factor, 16);
+        json += '"';
+        json += separator;
+        json += "\"mode\": \"";
+        json += modeToString(result.mode);
+        json += '"';
+        json += separator;
+        json += "\"bit_strength\": ";
+        append_number(json, result.bit_strength);
+        json += separator;
+        json += "\"version\": ";
+        append_number(json, static_cast<std::uint64_t>(result.version));
+        json += compact ? "}" : "\n}";
+    }
+
+    std::string to_json(const HashResult& result) {
+        std::string json;
+        write_json(json, result);
+        return json;
+    }
+
+    std::pmr::string to_json(const HashResult& result, std::pmr::memory_resource* resource) {
+        std::pmr::string json(resource);
+        write_json(json, result);
+        return json;
+    }
+
+    void append_json_line(std::string& out, const HashResult& result, Encoding encoding) {
+        write_json(out, result, true, encoding);
+        out += '\n';
     }
 
     std::string hash_with_metadata(const char* data, std::size_t length, double binding_duration_ms, CronoMode mode, unsigned int bit_strength) {
-        uint64_t tsc = CronoUtils::get_tsc();
-#ifdef _WIN32
-        uint64_t nano = CronoUtils::get_current_nanotime();
-#else
-        uint64_t nano = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-#endif
-        uint64_t binding_factor = 0;
-        if (binding_duration_ms > 0.0) {
-            binding_factor = CronoUtils::adaptive_binding_factor(binding_duration_ms);
-        }
-        std::string hash_result = hash(data, length, binding_duration_ms, mode, bit_strength);
-        std::ostringstream json;
-        json << "{\n";
-        json << "  \"hash\": \"" << hash_result << "\",\n";
-        json << "  \"tsc\": " << tsc << ",\n";
-        json << "  \"nano\": " << nano << ",\n";
-        json << "  \"binding_factor\": \"0x" << std::hex << binding_factor << std::dec << "\",\n";
-        json << "  \"mode\": \"" << modeToString(mode) << "\",\n";
-        json << "  \"bit_strength\": " << bit_strength << "\n";
-        json << "}";
-        return json.str();
+        // Ein einziger Pipeline-Durchlauf: Die Metadaten sind exakt die Werte, die in den Hash eingeflossen sind.
+        // Wie hash() bei V1, damit beide Legacy-Funktionen dieselbe Konstruktion liefern.
+        Hasher hasher({}, CronoVersion::V1);
+        return to_json(hasher.hash_with_result(data, length, binding_duration_ms, mode, bit_strength));
+    }
+
+    // --- Stream: inkrementelles Hashen ---
+
+    struct Stream::State {
+        CronoQuantum::AbsorbedInput input;
+        double binding_duration_ms;
+        CronoMode mode;
+        unsigned int bit_strength;
+        CronoEntropy::ClockSource* clock;
+        CronoEntropy::EntropyProvider* entropy;
+        std::pmr::memory_resource* scratch;
+        PipelineTrace trace;   // Zeit- und Bindungswerte des letzten final_into()
+    };
+
+    Stream::Stream(double binding_duration_ms, CronoMode mode, unsigned int bit_strength, CronoEntropy::Sources sources, std::pmr::memory_resource* scratch)
+        : state_(std::make_unique<State>()) {
+        state_->binding_duration_ms = binding_duration_ms;
+        state_->mode = mode;
+        state_->bit_strength = bit_strength;
+        state_->clock = sources.clock ? sources.clock : &CronoEntropy::production_clock();
+        state_->entropy = sources.entropy ? sources.entropy : &CronoEntropy::production_entropy();
+        state_->scratch = scratch;
+    }
+
+    Stream::~Stream() = default;
+    Stream::Stream(Stream&&) noexcept = default;
+    Stream& Stream::operator=(Stream&&) noexcept = default;
+
+    void Stream::update(std::span<const std::byte> chunk) {
+        state_->input.absorb(chunk.data(), chunk.size());
+    }
+
+    void Stream::update(const char* data, std::size_t length) {
+        update(std::span<const std::byte>(reinterpret_cast<const std::byte*>(data), length));
+    }
+
+    void Stream::reset() {
+        state_->input.reset();
+    }
+
+    std::uint64_t Stream::bytes_absorbed() const {
+        return state_->input.absorbed();
+    }
+
+    std::size_t Stream::final_into(std::span<std::byte> out) {
+        // Wie Hasher::hash_into(): Worte aus der Scratch-Ressource, direkt nach out, ohne HashResult
+        const unsigned int bit_strength = state_->bit_strength;
+        const std::size_t size = digest_size(bit_strength);
+        if (out.size() < size)
+            return 0;
+        CronoUtils::ScopedScratch scratch(state_->scratch);
+        state_->trace = PipelineTrace{};
+        WordBuffer words(word_count(bit_strength));
+        run_absorbed_pipeline(words.data(), state_->input, state_->binding_duration_ms, state_->mode, bit_strength, gather_environment(*state_->clock, *state_->entropy), state_->trace, nullptr);
+        store_words(out, words.data(), words.size());
+        reset();
+        return size;
+    }
+
+    HashResult Stream::final() {
+        HashResult result;
+        result.digest.resize(digest_size(state_->bit_strength));
+        final_into(result.digest);
+        describe_result(result, state_->trace, state_->mode, state_->bit_strength, CronoVersion::V3);
+        return result;
     }
 }
@@ -2,9 +2,27 @@
 #include "../include/crono_utils.h"  // notwendig für CronoUtils::rotate_left
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <random>
 #include <chrono>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define CRONO_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang benötigen die Zielarchitektur pro Funktion, MSVC erlaubt Intrinsics ohne Flag
+#if defined(CRONO_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CRONO_TARGET_AVX2 __attribute__((target("avx2")))
+#define CRONO_TARGET_AVX512 __attribute__((target("avx512f,avx512dq")))
+#else
+#define CRONO_TARGET_AVX2
+#define CRONO_TARGET_AVX512
+#endif
+
 namespace CronoMath {
 
     // 64 hochwertige 64-Bit-Primzahlen als statisches Array
@@ -44,10 +62,15 @@ namespace CronoMath {
     // Erzeuge einen modifizierbaren Vektor, der zur Laufzeit zufällig permutiert wird.
     std::array<uint64_t, 64> randomizedPrimes = STATIC_PRIMES;
 
+    // Kehrwerte passend zur permutierten Reihenfolge von randomizedPrimes
+    static std::array<Reciprocal, 64> randomizedReciprocals;
+
     // Einmalige Initialisierung der zufälligen Permutation
     static void initializeRandomizedPrimes() {
         unsigned seed = static_cast<unsigned>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
         std::shuffle(randomizedPrimes.begin(), randomizedPrimes.end(), std::default_random_engine(seed));
+        for (size_t i = 0; i < randomizedPrimes.size(); i++)
+            randomizedReciprocals[i] = make_reciprocal(randomizedPrimes[i]);
     }
 
     // Statische Initialisierung: Wird einmal beim Laden des Moduls ausgeführt
@@ -62,29 +85,38 @@ namespace CronoMath {
 
     // Die restlichen Funktionen:
     uint64_t mod_prime(uint64_t input) {
-        size_t index = input % randomizedPrimes.size();
-        uint64_t divisor = randomizedPrimes[index];
-        if (divisor == 0) {
-            // Fehlerbehandlung oder Fallback-Wert
-            divisor = 1; // Damit nicht durch 0 geteilt wird
-        }
-        return input % divisor;
+        // Tabellengröße ist eine Zweierpotenz: input % 64 == input & 63
+        return reduce(input, randomizedReciprocals[input & (randomizedReciprocals.size() - 1)]);
     }
 
 
+    static constexpr uint64_t extra_primes[8] = {
+        0xCbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL,
+        0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+        0x7F4A7C15E0F1A7B3ULL, 0xABCD12345678EF99ULL,
+        0x99FF00AA11335577ULL, 0xCAFEBABEDEADCAFEULL
+    };
+
+    static constexpr std::array<Reciprocal, 8> extra_reciprocals = {
+        make_reciprocal(extra_primes[0]), make_reciprocal(extra_primes[1]),
+        make_reciprocal(extra_primes[2]), make_reciprocal(extra_primes[3]),
+        make_reciprocal(extra_primes[4]), make_reciprocal(extra_primes[5]),
+        make_reciprocal(extra_primes[6]), make_reciprocal(extra_primes[7])
+    };
+
+    const uint64_t* EXTRA_PRIMES = extra_primes;
+    const int NUM_EXTRA_PRIMES = 8;
+
     uint64_t mod_prime256(uint64_t input, int index) {
-        static const uint64_t extra_primes[8] = {
-            0xCbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL,
-            0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
-            0x7F4A7C15E0F1A7B3ULL, 0xABCD12345678EF99ULL,
-            0x99FF00AA11335577ULL, 0xCAFEBABEDEADCAFEULL
-        };
         uint64_t rotated = CronoUtils::rotate_left(input, (index * 11) % 64);
-        return rotated % extra_primes[index % 8];
+        return reduce(rotated, extra_reciprocals[index % 8]);
     }
 
 
     static const uint64_t SECP_CONSTANT = 0xD1B54A32D192ED03ULL;
+    static const uint64_t MIX_SALT1 = 0xA5A5A5A5A5A5A5A5ULL;
+    static const uint64_t MIX_SALT2 = 0xDEADBEEF1337BEEFULL;
+    static const uint64_t MIX_SALT3 = 0xC0FFEE1234567890ULL;
 
     uint64_t endomorph_transform(uint64_t input, uint64_t seed) {
         input ^= seed;
@@ -96,12 +128,240 @@ namespace CronoMath {
     }
 
     uint64_t hash_const_mix(uint64_t input) {
-        const uint64_t salt1 = 0xA5A5A5A5A5A5A5A5ULL;
-        const uint64_t salt2 = 0xDEADBEEF1337BEEFULL;
-        const uint64_t salt3 = 0xC0FFEE1234567890ULL;
-        const uint64_t rot = CronoUtils::rotate_left(input ^ salt1, 17);
-        const uint64_t mix = (rot ^ salt2) * salt3;
+        const uint64_t rot = CronoUtils::rotate_left(input ^ MIX_SALT1, 17);
+        const uint64_t mix = (rot ^ MIX_SALT2) * MIX_SALT3;
         return mix ^ (mix >> 31);
     }
 
+    // --- Wort-Batch-Kernel (skalar, AVX2, AVX-512) ---
+
+    // Größter Quotient input / extra_primes[k] für k = 0..3; so oft muss mod_prime256 höchstens subtrahieren
+    static constexpr int MOD256_MAX_QUOTIENT = static_cast<int>(~0ULL / 0x152fecd8f70e5939ULL);
+
+    static void endomorph_words_scalar(uint64_t* words, std::size_t n, uint64_t seed) {
+        for (std::size_t i = 0; i < n; i++)
+            words[i] = endomorph_transform(words[i], seed);
+    }
+
+    static void const_mix_words_scalar(uint64_t* words, std::size_t n) {
+        for (std::size_t i = 0; i < n; i++)
+            words[i] = hash_const_mix(words[i]);
+    }
+
+    static void mod_prime256_words_scalar(uint64_t* words, std::size_t n) {
+        for (std::size_t i = 0; i < n; i++)
+            words[i] = mod_prime256(words[i], static_cast<int>(i % 4));
+    }
+
+#ifdef CRONO_X86
+    // AVX2 kennt keine 64-Bit-Multiplikation: low64(a * b) aus drei 32x32-Produkten zusammensetzen
+    CRONO_TARGET_AVX2 static inline __m256i mullo64_avx2(__m256i a, __m256i b) {
+        const __m256i b_swap = _mm256_shuffle_epi32(b, 0xB1);                       // hi/lo je 64-Bit-Lane tauschen
+        const __m256i cross = _mm256_mullo_epi32(a, b_swap);                         // lo(a)*hi(b), hi(a)*lo(b)
+        const __m256i cross_sum = _mm256_add_epi32(cross, _mm256_srli_epi64(cross, 32));
+        return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross_sum, 32));
+    }
+
+    CRONO_TARGET_AVX2 static inline __m256i rotl64_avx2(__m256i x, int r) {
+        return _mm256_or_si256(_mm256_slli_epi64(x, r), _mm256_srli_epi64(x, 64 - r));
+    }
+
+    CRONO_TARGET_AVX2 static void endomorph_words_avx2(uint64_t* words, std::size_t n, uint64_t seed) {
+        const __m256i s = _mm256_set1_epi64x(static_cast<long long>(seed));
+        const __m256i k = _mm256_set1_epi64x(static_cast<long long>(SECP_CONSTANT));
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            x = mullo64_avx2(_mm256_xor_si256(x, s), k);
+            x = rotl64_avx2(x, 13);
+            x = mullo64_avx2(_mm256_xor_si256(x, s), k);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i), x);
+        }
+        endomorph_words_scalar(words + i, n - i, seed);
+    }
+
+    CRONO_TARGET_AVX2 static void const_mix_words_avx2(uint64_t* words, std::size_t n) {
+        const __m256i s1 = _mm256_set1_epi64x(static_cast<long long>(MIX_SALT1));
+        const __m256i s2 = _mm256_set1_epi64x(static_cast<long long>(MIX_SALT2));
+        const __m256i s3 = _mm256_set1_epi64x(static_cast<long long>(MIX_SALT3));
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            x = rotl64_avx2(_mm256_xor_si256(x, s1), 17);
+            x = mullo64_avx2(_mm256_xor_si256(x, s2), s3);
+            x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i), x);
+        }
+        const_mix_words_scalar(words + i, n - i);
+    }
+
+    // Lane k verarbeitet Index k: Rotation um k * 11, dann Reduktion durch wiederholtes Subtrahieren
+    // (AVX2 vergleicht nur vorzeichenbehaftet, daher Vorzeichenbit-Verschiebung für den unsigned-Vergleich)
+    CRONO_TARGET_AVX2 static void mod_prime256_words_avx2(uint64_t* words, std::size_t n) {
+        const __m256i p = _mm256_setr_epi64x(static_cast<long long>(extra_primes[0]), static_cast<long long>(extra_primes[1]),
+                                             static_cast<long long>(extra_primes[2]), static_cast<long long>(extra_primes[3]));
+        const __m256i left = _mm256_setr_epi64x(0, 11, 22, 33);
+        const __m256i right = _mm256_setr_epi64x(64, 53, 42, 31);
+        const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+        const __m256i p_signed = _mm256_xor_si256(p, sign);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            x = _mm256_or_si256(_mm256_sllv_epi64(x, left), _mm256_srlv_epi64(x, right));
+            for (int q = 0; q < MOD256_MAX_QUOTIENT; q++) {
+                const __m256i below = _mm256_cmpgt_epi64(p_signed, _mm256_xor_si256(x, sign));
+                x = _mm256_sub_epi64(x, _mm256_andnot_si256(below, p));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i), x);
+        }
+        for (; i < n; i++)
+            words[i] = mod_prime256(words[i], static_cast<int>(i % 4));
+    }
+
+    // GCC 12 meldet in den AVX-512-Headern (_mm512_undefined_epi32) fälschlich -Wmaybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    CRONO_TARGET_AVX512 static void endomorph_words_avx512(uint64_t* words, std::size_t n, uint64_t seed) {
+        const __m512i s = _mm512_set1_epi64(static_cast<long long>(seed));
+        const __m512i k = _mm512_set1_epi64(static_cast<long long>(SECP_CONSTANT));
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512i x = _mm512_loadu_si512(words + i);
+            x = _mm512_mullo_epi64(_mm512_xor_si512(x, s), k);
+            x = _mm512_rol_epi64(x, 13);
+            x = _mm512_mullo_epi64(_mm512_xor_si512(x, s), k);
+            _mm512_storeu_si512(words + i, x);
+        }
+        endomorph_words_scalar(words + i, n - i, seed);
+    }
+
+    CRONO_TARGET_AVX512 static void const_mix_words_avx512(uint64_t* words, std::size_t n) {
+        const __m512i s1 = _mm512_set1_epi64(static_cast<long long>(MIX_SALT1));
+        const __m512i s2 = _mm512_set1_epi64(static_cast<long long>(MIX_SALT2));
+        const __m512i s3 = _mm512_set1_epi64(static_cast<long long>(MIX_SALT3));
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512i x = _mm512_loadu_si512(words + i);
+            x = _mm512_rol_epi64(_mm512_xor_si512(x, s1), 17);
+            x = _mm512_mullo_epi64(_mm512_xor_si512(x, s2), s3);
+            x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 31));
+            _mm512_storeu_si512(words + i, x);
+        }
+        const_mix_words_scalar(words + i, n - i);
+    }
+
+    CRONO_TARGET_AVX512 static void mod_prime256_words_avx512(uint64_t* words, std::size_t n) {
+        const __m512i p = _mm512_setr_epi64(static_cast<long long>(extra_primes[0]), static_cast<long long>(extra_primes[1]),
+                                            static_cast<long long>(extra_primes[2]), static_cast<long long>(extra_primes[3]),
+                                            static_cast<long long>(extra_primes[0]), static_cast<long long>(extra_primes[1]),
+                                            static_cast<long long>(extra_primes[2]), static_cast<long long>(extra_primes[3]));
+        const __m512i rot = _mm512_setr_epi64(0, 11, 22, 33, 0, 11, 22, 33);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512i x = _mm512_rolv_epi64(_mm512_loadu_si512(words + i), rot);
+            for (int q = 0; q < MOD256_MAX_QUOTIENT; q++) {
+                const __mmask8 ge = _mm512_cmpge_epu64_mask(x, p);
+                x = _mm512_mask_sub_epi64(x, ge, x, p);
+            }
+            _mm512_storeu_si512(words + i, x);
+        }
+        for (; i < n; i++)
+            words[i] = mod_prime256(words[i], static_cast<int>(i % 4));
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    static bool cpu_supports(SimdLevel level) {
+        if (level == SimdLevel::Scalar)
+            return true;
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        if (level == SimdLevel::AVX2)
+            return __builtin_cpu_supports("avx2");
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq");
+#elif defined(_MSC_VER)
+        int regs[4] = { 0 };
+        __cpuid(regs, 0);
+        if (regs[0] < 7)
+            return false;
+        __cpuid(regs, 1);
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        if (!osxsave)
+            return false;
+        const unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(regs, 7, 0);
+        if (level == SimdLevel::AVX2)
+            return (xcr0 & 0x6) == 0x6 && (regs[1] & (1 << 5)) != 0;
+        // AVX-512F (Bit 16) und AVX-512DQ (Bit 17), OS muss opmask/ZMM-Zustand sichern
+        return (xcr0 & 0xE6) == 0xE6 && (regs[1] & (1 << 16)) != 0 && (regs[1] & (1 << 17)) != 0;
+#else
+        return false;
+#endif
+    }
+#else
+    static bool cpu_supports(SimdLevel level) {
+        return level == SimdLevel::Scalar;
+    }
+#endif
+
+    struct WordKernels {
+        SimdLevel level;
+        void (*endomorph)(uint64_t*, std::size_t, uint64_t);
+        void (*const_mix)(uint64_t*, std::size_t);
+        void (*mod_prime256)(uint64_t*, std::size_t);
+    };
+
+    static constexpr WordKernels scalarKernels = { SimdLevel::Scalar, endomorph_words_scalar, const_mix_words_scalar, mod_prime256_words_scalar };
+#ifdef CRONO_X86
+    static constexpr WordKernels avx2Kernels = { SimdLevel::AVX2, endomorph_words_avx2, const_mix_words_avx2, mod_prime256_words_avx2 };
+    static constexpr WordKernels avx512Kernels = { SimdLevel::AVX512, endomorph_words_avx512, const_mix_words_avx512, mod_prime256_words_avx512 };
+#endif
+
+    static const WordKernels* kernels_for(SimdLevel level) {
+#ifdef CRONO_X86
+        if (level == SimdLevel::AVX512)
+            return &avx512Kernels;
+        if (level == SimdLevel::AVX2)
+            return &avx2Kernels;
+#endif
+        return &scalarKernels;
+    }
+
+    // CPUID-Dispatch: Einmal beim Laden des Moduls die beste Variante wählen. Ein atomarer Zeiger auf
+    // unveränderliche Tabellen, damit force_simd_level() parallel zu laufenden Aufrufen umschalten darf.
+    static std::atomic<const WordKernels*> activeKernels = []() {
+        if (cpu_supports(SimdLevel::AVX512))
+            return kernels_for(SimdLevel::AVX512);
+        if (cpu_supports(SimdLevel::AVX2))
+            return kernels_for(SimdLevel::AVX2);
+        return kernels_for(SimdLevel::Scalar);
+        }();
+
+    SimdLevel simd_level() {
+        return activeKernels.load(std::memory_order_acquire)->level;
+    }
+
+    bool force_simd_level(SimdLevel level) {
+        if (!cpu_supports(level))
+            return false;
+        activeKernels.store(kernels_for(level), std::memory_order_release);
+        return true;
+    }
+
+    void endomorph_transform_words(uint64_t* words, std::size_t n, uint64_t seed) {
+        activeKernels.load(std::memory_order_acquire)->endomorph(words, n, seed);
+    }
+
+    void hash_const_mix_words(uint64_t* words, std::size_t n) {
+        activeKernels.load(std::memory_order_acquire)->const_mix(words, n);
+    }
+
+    void mod_prime256_words(uint64_t* words, std::size_t n) {
+        activeKernels.load(std::memory_order_acquire)->mod_prime256(words, n);
+    }
+
 } // namespace CronoMath
@@ -0,0 +1,97 @@
+#include "../include/crono_pool.h"
+#include "../include/crono_utils.h"  // current_pid
+#include <algorithm>
+#include <memory>
+
+namespace CronoUtils {
+
+    WorkerPool::WorkerPool(unsigned int threads) : pid_(current_pid()) {
+        if (threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if (threads == 0)
+            threads = 1;
+        for (unsigned int i = 0; i < threads; i++) {
+            threads_.emplace_back([this]() { run(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& t : threads_) {
+            t.join();
+        }
+    }
+
+    void WorkerPool::run() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+                // Beim Beenden werden noch eingereihte Aufträge abgearbeitet
+                if (tasks_.empty())
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+            completed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void WorkerPool::submit(std::function<void()> task) {
+        if (current_pid() != pid_) {
+            task();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        ready_.notify_one();
+    }
+
+    // Gemeinsamer Zustand eines parallel_for; Helfer, die erst nach dem Ende starten, finden keinen Index mehr
+    struct ParallelForState {
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<std::size_t> done{ 0 };
+        std::size_t n = 0;
+        const std::function<void(std::size_t)>* fn = nullptr;
+
+        void work() {
+            for (;;) {
+                const std::size_t i = next.fetch_add(1);
+                if (i >= n)
+                    return;
+                (*fn)(i);
+                if (done.fetch_add(1) + 1 == n)
+                    done.notify_all();
+            }
+        }
+    };
+
+    void WorkerPool::parallel_for(std::size_t n, const std::function<void(std::size_t)>& fn) {
+        if (n == 0)
+            return;
+        auto state = std::make_shared<ParallelForState>();
+        state->n = n;
+        state->fn = &fn;
+        const std::size_t helpers = current_pid() == pid_ ? std::min<std::size_t>(n - 1, threads_.size()) : 0;
+        for (std::size_t h = 0; h < helpers; h++) {
+            submit([state]() { state->work(); });
+        }
+        state->work();  // Der aufrufende Thread arbeitet mit
+        for (std::size_t done = state->done.load(); done < n; done = state->done.load()) {
+            state->done.wait(done);
+        }
+    }
+
+    WorkerPool& WorkerPool::shared() {
+        static WorkerPool pool;
+        return pool;
+    }
+}
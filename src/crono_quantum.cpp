@@ -1,15 +1,25 @@
 ﻿#include "../include/crono_quantum.h"
+#include "../include/crono_entropy.h"  // random_source_epoch, random_source_active
+#include "../include/crono_ring.h"
+#include "../include/crono_utils.h"    // current_pid
+#include "../include/crono_arena.h"    // scratch_resource
 #include <oqs/sha3.h>   // SHA3 Header von liboqs
+#include <oqs/sha3x4.h> // Vierfach-parallele SHAKE128-Variante
 #include <oqs/oqs.h>    // Allgemeine OQS-Funktionen
 #include <oqs/kem.h>    // Für KEM-Funktionen und -Längen
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace CronoQuantum {
 
     uint64_t quantum_mix(uint64_t input, const char* data, std::size_t length) {
         size_t total_len = sizeof(input) + length;
-        std::vector<unsigned char> buffer(total_len);
+        std::pmr::vector<unsigned char> buffer(total_len, CronoUtils::scratch_resource());
 
         for (size_t i = 0; i < sizeof(input); i++) {
             buffer[i] = static_cast<unsigned char>((input >> (8 * i)) & 0xFF);
@@ -26,60 +36,429 @@ namespace CronoQuantum {
         return qm;
     }
 
-    uint64_t quantum_mix_kyber(uint64_t input, const char* data, std::size_t length) {
-        // Erstelle einen kombinierten Puffer wie in quantum_mix
-        size_t total_len = sizeof(input) + length;
-        std::vector<unsigned char> buffer(total_len);
-
+    // Schreibt input (Little-Endian) gefolgt von data nach buffer – das Eingabeformat von quantum_mix
+    static void load_mix_input(unsigned char* buffer, uint64_t input, const char* data, std::size_t length) {
         for (size_t i = 0; i < sizeof(input); i++) {
             buffer[i] = static_cast<unsigned char>((input >> (8 * i)) & 0xFF);
         }
-        std::memcpy(buffer.data() + sizeof(input), data, length);
+        std::memcpy(buffer + sizeof(input), data, length);
+    }
 
-        // Nutze SHAKE128, um einen 64-Byte Seed zu erzeugen
-        unsigned char shake_output[64];
-        OQS_SHA3_shake128(shake_output, sizeof(shake_output), buffer.data(), total_len);
+    static uint64_t load_le64(const unsigned char* bytes) {
+        uint64_t value = 0;
+        for (size_t i = 0; i < 8; i++) {
+            value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
 
-        // Initialisiere Kyber512 KEM über den Algorithmusnamen
-        OQS_KEM* kem = OQS_KEM_new("Kyber512");
-        if (kem == nullptr) {
-            // Fallback: interpretiere SHAKE-Ergebnis als uint64_t
-            uint64_t fallback = 0;
-            for (size_t i = 0; i < 8; i++) {
-                fallback |= static_cast<uint64_t>(shake_output[i]) << (8 * i);
+    void quantum_mix_words(uint64_t* words, std::size_t n, const char* data, std::size_t length) {
+        // Alle vier Lanes teilen die Eingabelänge; nur die ersten 8 Bytes des SHAKE-Outputs fließen ein,
+        // und SHAKE-Ausgaben sind Präfixe längerer Ausgaben – daher genügt outlen = 8
+        const size_t total_len = sizeof(uint64_t) + length;
+        unsigned char fixed[4][128];
+        std::pmr::vector<unsigned char> large(CronoUtils::scratch_resource());
+        unsigned char* lanes[4] = { fixed[0], fixed[1], fixed[2], fixed[3] };
+        if (total_len > sizeof(fixed[0])) {
+            large.resize(4 * total_len);
+            for (size_t l = 0; l < 4; l++) {
+                lanes[l] = large.data() + l * total_len;
+            }
+        }
+
+        std::size_t i = 0;
+        if (n >= 4) {
+            // Die Daten sind für alle Worte gleich und werden nur einmal kopiert
+            for (size_t l = 0; l < 4; l++) {
+                std::memcpy(lanes[l] + sizeof(uint64_t), data, length);
+            }
+            unsigned char out[4][8];
+            for (; i + 4 <= n; i += 4) {
+                for (size_t l = 0; l < 4; l++) {
+                    for (size_t b = 0; b < sizeof(uint64_t); b++) {
+                        lanes[l][b] = static_cast<unsigned char>((words[i + l] >> (8 * b)) & 0xFF);
+                    }
+                }
+                OQS_SHA3_shake128_x4(out[0], out[1], out[2], out[3], sizeof(out[0]), lanes[0], lanes[1], lanes[2], lanes[3], total_len);
+                for (size_t l = 0; l < 4; l++) {
+                    words[i + l] ^= load_le64(out[l]);
+                }
             }
-            return fallback;
         }
+        // Skalarer Rest
+        for (; i < n; i++) {
+            load_mix_input(lanes[0], words[i], data, length);
+            unsigned char out[8];
+            OQS_SHA3_shake128(out, sizeof(out), lanes[0], total_len);
+            words[i] ^= load_le64(out);
+        }
+    }
 
-        // Verwende die Membervariablen, die die Längen der jeweiligen Puffer enthalten
-        size_t pk_len = kem->length_public_key;
-        size_t ct_len = kem->length_ciphertext;
-        size_t ss_len = kem->length_shared_secret;
+    // Expandierter Public Key (Matrix A, t und H(pk)); die AVX2-Implementierung erwartet 32-Byte-Ausrichtung
+    struct alignas(32) KyberSession::ExpandedKey {
+#if defined(OQS_ENABLE_KEM_kyber_512)
+        uint8_t bytes[OQS_KEM_kyber_512_length_expanded_public_key];
+#else
+        uint8_t bytes[1];
+#endif
+    };
 
-        std::vector<unsigned char> public_key(pk_len);
-        std::vector<unsigned char> ciphertext(ct_len);
-        std::vector<unsigned char> shared_secret(ss_len);
+    KyberSession::KyberSession(uint64_t rotate_every) : rotate_every_(rotate_every > 0 ? rotate_every : 1) {
+        // Initialisiere Kyber512 KEM über den Algorithmusnamen – einmal pro Sitzung
+        kem_ = OQS_KEM_new("Kyber512");
+        if (kem_ != nullptr) {
+            public_key_.resize(kem_->length_public_key);
+            secret_key_.resize(kem_->length_secret_key);
+            expanded_key_ = std::make_unique<ExpandedKey>();
+            ciphertext_.resize(kem_->length_ciphertext);
+            shared_secret_.resize(kem_->length_shared_secret);
+        }
+    }
 
-        // Erzeuge einen zufälligen Public Key (nur für den Encaps-Aufruf benötigt)
-        OQS_randombytes(public_key.data(), pk_len);
+    KyberSession::~KyberSession() {
+        if (kem_ != nullptr) {
+            OQS_KEM_free(kem_);
+        }
+    }
+
+    void KyberSession::rotate() {
+#if defined(OQS_ENABLE_KEM_kyber_512)
+        // Echtes Schlüsselpaar aus 64 Zufallsbytes statt eines zufälligen 800-Byte-Public-Keys
+        uint8_t seed[OQS_KEM_kyber_512_length_keypair_seed];
+        OQS_randombytes(seed, sizeof(seed));
+        OQS_KEM_kyber_512_keypair_derand(public_key_.data(), secret_key_.data(), seed);
+        OQS_KEM_kyber_512_expand_public_key(expanded_key_->bytes, public_key_.data());
+#else
+        OQS_randombytes(public_key_.data(), public_key_.size());
+#endif
+        uses_since_rotation_ = 0;
+        epoch_ = CronoEntropy::random_source_epoch();
+        keyed_ = true;
+        rotations_++;
+    }
 
-        if (OQS_KEM_encaps(kem, ciphertext.data(), shared_secret.data(), public_key.data()) != OQS_SUCCESS) {
-            // Fehlerfall: Fallback
-            uint64_t fallback = 0;
-            for (size_t i = 0; i < 8; i++) {
-                fallback |= static_cast<uint64_t>(shake_output[i]) << (8 * i);
+    const uint8_t* KyberSession::encapsulate() {
+        if (kem_ == nullptr)
+            return nullptr;
+        if (!keyed_ || uses_since_rotation_ >= rotate_every_ || epoch_ != CronoEntropy::random_source_epoch())
+            rotate();
+        uses_since_rotation_++;
+        encapsulations_++;
+        if (OQS_KEM_encaps(kem_, ciphertext_.data(), shared_secret_.data(), public_key_.data()) != OQS_SUCCESS)
+            return nullptr;
+        return shared_secret_.data();
+    }
+
+    const uint8_t* KyberSession::encapsulate(const uint8_t* coins) {
+#if defined(OQS_ENABLE_KEM_kyber_512)
+        static_assert(COIN_BYTES == OQS_KEM_kyber_512_length_encaps_seed, "Kyber512 erwartet 32 Byte Coins");
+        if (kem_ == nullptr)
+            return nullptr;
+        if (!keyed_ || uses_since_rotation_ >= rotate_every_ || epoch_ != CronoEntropy::random_source_epoch())
+            rotate();
+        uses_since_rotation_++;
+        encapsulations_++;
+        if (OQS_KEM_kyber_512_encaps_expanded_derand(ciphertext_.data(), shared_secret_.data(), expanded_key_->bytes, coins) != OQS_SUCCESS)
+            return nullptr;
+        return shared_secret_.data();
+#else
+        (void)coins;
+        return encapsulate();
+#endif
+    }
+
+    KyberSession& KyberSession::for_this_thread() {
+        static thread_local KyberSession session;
+        return session;
+    }
+
+    // --- Pool vorab berechneter Kapselungen ---
+
+    // Kyber512 liefert 32 Byte Shared Secret
+    using SharedSecret = std::array<uint8_t, 32>;
+
+    class EncapsulationPool {
+    public:
+        explicit EncapsulationPool(const EncapsulationPoolOptions& options)
+            : options_(options), ring_(options.capacity), pid_(CronoUtils::current_pid()) {
+            const unsigned int producers = options.producers > 0 ? options.producers : 1;
+            for (unsigned int i = 0; i < producers; i++) {
+                threads_.emplace_back([this]() { produce(); });
             }
-            OQS_KEM_free(kem);
-            return fallback;
+        }
+
+        ~EncapsulationPool() {
+            running_.store(false);
+            // Wartende Produzenten und Konsumenten wecken
+            space_.fetch_add(1);
+            space_.notify_all();
+            available_.fetch_add(1);
+            available_.notify_all();
+            for (auto& t : threads_) {
+                t.join();
+            }
+        }
+
+        // false: Pool leer (Inline-Modus), gestoppt oder von einem fork() geerbt – der Aufrufer kapselt selbst
+        bool take(SharedSecret& out) {
+            // Im Kindprozess laufen die Produzenten nicht mehr, und die Einträge gehören dem Elternprozess
+            if (CronoUtils::current_pid() != pid_)
+                return false;
+            if (pop(out))
+                return true;
+            if (options_.when_empty == PoolExhaustion::Inline) {
+                fallbacks_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            waits_.fetch_add(1, std::memory_order_relaxed);
+            for (;;) {
+                const uint64_t seen = available_.load();
+                if (pop(out))
+                    return true;
+                if (!running_.load() || !producing_.load()) {
+                    fallbacks_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                available_.wait(seen);
+            }
+        }
+
+        EncapsulationPoolStats stats() const {
+            EncapsulationPoolStats stats;
+            stats.running = running_.load() && producing_.load();
+            stats.depth = ring_.size_approx();
+            stats.capacity = ring_.capacity();
+            stats.produced = produced_.load(std::memory_order_relaxed);
+            stats.consumed = consumed_.load(std::memory_order_relaxed);
+            stats.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+            stats.waits = waits_.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        bool pop(SharedSecret& out) {
+            if (!ring_.try_pop(out))
+                return false;
+            consumed_.fetch_add(1, std::memory_order_relaxed);
+            space_.fetch_add(1);
+            space_.notify_one();
+            return true;
+        }
+
+        void produce() {
+            KyberSession session(options_.rotate_every);
+            SharedSecret secret;
+            while (running_.load()) {
+                const uint8_t* shared_secret = session.encapsulate();
+                if (shared_secret == nullptr) {
+                    // Kyber512 nicht verfügbar: Konsumenten fallen inline zurück
+                    producing_.store(false);
+                    available_.fetch_add(1);
+                    available_.notify_all();
+                    return;
+                }
+                std::memcpy(secret.data(), shared_secret, secret.size());
+                for (;;) {
+                    const uint64_t seen = space_.load();
+                    if (ring_.try_push(secret))
+                        break;
+                    if (!running_.load())
+                        return;
+                    space_.wait(seen);
+                }
+                produced_.fetch_add(1, std::memory_order_relaxed);
+                available_.fetch_add(1);
+                available_.notify_one();
+            }
+        }
+
+        const EncapsulationPoolOptions options_;
+        CronoUtils::MpmcRing<SharedSecret> ring_;
+        const long pid_;
+        std::vector<std::thread> threads_;
+        std::atomic<bool> running_{ true };
+        std::atomic<bool> producing_{ true };
+        // Generationszähler für atomic::wait/notify: space_ nach jeder Entnahme, available_ nach jedem Eintrag
+        std::atomic<uint64_t> space_{ 0 };
+        std::atomic<uint64_t> available_{ 0 };
+        std::atomic<uint64_t> produced_{ 0 };
+        std::atomic<uint64_t> consumed_{ 0 };
+        std::atomic<uint64_t> fallbacks_{ 0 };
+        std::atomic<uint64_t> waits_{ 0 };
+    };
+
+    static std::mutex poolMutex;                 // Serialisiert start/stop
+    static std::atomic<bool> poolEnabled{ false }; // Schneller Test auf dem Anfragepfad
+    static std::atomic<std::shared_ptr<EncapsulationPool>> activePool;
+
+    bool start_encapsulation_pool(const EncapsulationPoolOptions& options) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (activePool.load() != nullptr)
+            return false;
+        // Verfügbarkeit prüfen, bevor Threads gestartet werden
+        OQS_KEM* probe = OQS_KEM_new("Kyber512");
+        if (probe == nullptr)
+            return false;
+        OQS_KEM_free(probe);
+        activePool.store(std::make_shared<EncapsulationPool>(options));
+        poolEnabled.store(true);
+        return true;
+    }
+
+    void stop_encapsulation_pool() {
+        std::shared_ptr<EncapsulationPool> pool;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            poolEnabled.store(false);
+            pool = activePool.exchange(nullptr);
+        }
+        // Laufende Entnahmen halten eigene Referenzen; der letzte Besitzer beendet die Produzenten
+    }
+
+    EncapsulationPoolStats encapsulation_pool_stats() {
+        std::shared_ptr<EncapsulationPool> pool = activePool.load();
+        return pool ? pool->stats() : EncapsulationPoolStats{};
+    }
+
+    // Verknüpft einen 64-Byte-SHAKE-Seed mit einem Kyber-Shared-Secret (aus dem Pool oder der Sitzung)
+    static uint64_t combine_with_encapsulation(const unsigned char* shake_output, KyberSession& session) {
+        // Vorab berechnetes Shared Secret aus dem Pool, sofern keine Test-/Replay-Zufallsquelle aktiv ist
+        SharedSecret pooled;
+        const uint8_t* shared_secret = nullptr;
+        if (poolEnabled.load(std::memory_order_relaxed) && !CronoEntropy::random_source_active()) {
+            std::shared_ptr<EncapsulationPool> pool = activePool.load();
+            if (pool && pool->take(pooled))
+                shared_secret = pooled.data();
+        }
+        // Sonst deterministisch kapseln: die Coins liefert der SHAKE-Seed, nicht OQS_randombytes
+        if (shared_secret == nullptr)
+            shared_secret = session.encapsulate(shake_output + 64 - KyberSession::COIN_BYTES);
+        if (shared_secret == nullptr) {
+            // Fallback: interpretiere SHAKE-Ergebnis als uint64_t
+            return load_le64(shake_output);
         }
 
         // Kombiniere das Shared Secret mit dem SHAKE-Seed via XOR zu einem 64-Bit Wert
         uint64_t qm2 = 0;
-        for (size_t i = 0; i < 8 && i < ss_len; i++) {
+        for (size_t i = 0; i < 8; i++) {
             qm2 |= static_cast<uint64_t>(shared_secret[i] ^ shake_output[i]) << (8 * i);
         }
-
-        OQS_KEM_free(kem);
         return qm2;
     }
+
+    uint64_t quantum_mix_kyber(uint64_t input, const char* data, std::size_t length) {
+        return quantum_mix_kyber(input, data, length, KyberSession::for_this_thread());
+    }
+
+    uint64_t quantum_mix_kyber(uint64_t input, const char* data, std::size_t length, KyberSession& session) {
+        // Kombinierter Puffer wie in quantum_mix; kurze Eingaben (V2-Auszug) bleiben auf dem Stack
+        size_t total_len = sizeof(input) + length;
+        unsigned char fixed[128];
+        std::pmr::vector<unsigned char> large(CronoUtils::scratch_resource());
+        unsigned char* buffer = fixed;
+        if (total_len > sizeof(fixed)) {
+            large.resize(total_len);
+            buffer = large.data();
+        }
+        load_mix_input(buffer, input, data, length);
+
+        // Nutze SHAKE128, um einen 64-Byte Seed zu erzeugen
+        unsigned char shake_output[64];
+        OQS_SHA3_shake128(shake_output, sizeof(shake_output), buffer, total_len);
+        return combine_with_encapsulation(shake_output, session);
+    }
+
+    // --- V3: einmal absorbierte Eingabe ---
+
+    struct AbsorbedInput::Contexts {
+        OQS_SHA3_shake128_inc_ctx base;
+        OQS_SHA3_shake128_inc_ctx scratch;
+    };
+
+    AbsorbedInput::AbsorbedInput() : ctx_(std::make_unique<Contexts>()) {
+        OQS_SHA3_shake128_inc_init(&ctx_->base);
+        OQS_SHA3_shake128_inc_init(&ctx_->scratch);
+    }
+
+    AbsorbedInput::~AbsorbedInput() {
+        if (ctx_) {
+            OQS_SHA3_shake128_inc_ctx_release(&ctx_->base);
+            OQS_SHA3_shake128_inc_ctx_release(&ctx_->scratch);
+        }
+    }
+
+    AbsorbedInput::AbsorbedInput(AbsorbedInput&& other) noexcept
+        : ctx_(std::move(other.ctx_)), absorbed_(other.absorbed_) {
+        other.absorbed_ = 0;
+    }
+
+    AbsorbedInput& AbsorbedInput::operator=(AbsorbedInput&& other) noexcept {
+        if (this != &other) {
+            if (ctx_) {
+                OQS_SHA3_shake128_inc_ctx_release(&ctx_->base);
+                OQS_SHA3_shake128_inc_ctx_release(&ctx_->scratch);
+            }
+            ctx_ = std::move(other.ctx_);
+            // absorbed_ bildet den Längenblock der V3-Lane-Ableitung (crono_hash.cpp) und muss mitwandern
+            absorbed_ = other.absorbed_;
+            other.absorbed_ = 0;
+        }
+        return *this;
+    }
+
+    AbsorbedInput::Contexts& AbsorbedInput::contexts() const {
+        // Der Move hat die Kontexte übergeben; absorbed_ ist dann bereits 0
+        if (!ctx_) {
+            ctx_ = std::make_unique<Contexts>();
+            OQS_SHA3_shake128_inc_init(&ctx_->base);
+            OQS_SHA3_shake128_inc_init(&ctx_->scratch);
+        }
+        return *ctx_;
+    }
+
+    void AbsorbedInput::absorb(const void* data, std::size_t length) {
+        OQS_SHA3_shake128_inc_absorb(&contexts().base, static_cast<const uint8_t*>(data), length);
+        absorbed_ += length;
+    }
+
+    void AbsorbedInput::reset() {
+        OQS_SHA3_shake128_inc_ctx_reset(&contexts().base);
+        absorbed_ = 0;
+    }
+
+    void AbsorbedInput::derive(const uint8_t* suffix, std::size_t suffix_length, uint8_t* out, std::size_t out_length) const {
+        // Klon statt erneutem Absorbieren: Kosten unabhängig von der Eingabelänge
+        Contexts& ctx = contexts();
+        OQS_SHA3_shake128_inc_ctx_clone(&ctx.scratch, &ctx.base);
+        OQS_SHA3_shake128_inc_absorb(&ctx.scratch, suffix, suffix_length);
+        OQS_SHA3_shake128_inc_finalize(&ctx.scratch);
+        OQS_SHA3_shake128_inc_squeeze(out, out_length, &ctx.scratch);
+    }
+
+    // Suffix einer Wort-Ableitung: Domänen-Tag, dann das Wort (Little-Endian)
+    static void derive_word(const AbsorbedInput& input, uint8_t tag, uint64_t word, uint8_t* out, std::size_t out_length) {
+        uint8_t suffix[1 + sizeof(uint64_t)];
+        suffix[0] = tag;
+        for (size_t i = 0; i < sizeof(uint64_t); i++) {
+            suffix[1 + i] = static_cast<uint8_t>(word >> (8 * i));
+        }
+        input.derive(suffix, sizeof(suffix), out, out_length);
+    }
+
+    void quantum_mix_words(uint64_t* words, std::size_t n, const AbsorbedInput& input) {
+        for (std::size_t i = 0; i < n; i++) {
+            unsigned char out[8];
+            derive_word(input, QUANTUM_MIX_TAG, words[i], out, sizeof(out));
+            words[i] ^= load_le64(out);
+        }
+    }
+
+    void quantum_mix_kyber_words(uint64_t* words, std::size_t n, const AbsorbedInput& input) {
+        KyberSession& session = KyberSession::for_this_thread();
+        for (std::size_t i = 0; i < n; i++) {
+            unsigned char shake_output[64];
+            derive_word(input, QUANTUM_KYBER_TAG, words[i], shake_output, sizeof(shake_output));
+            words[i] ^= combine_with_encapsulation(shake_output, session);
+        }
+    }
 }
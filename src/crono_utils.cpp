@@ -4,22 +4,32 @@
 
 #include "../include/crono_utils.h"
 #include "../include/crono_math.h"  // Für endomorph_transform etc.
+#include "../include/crono_binding.h"  // BindingScheduler für die Zeitbindung
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 #include <algorithm>
 #include <oqs/oqs.h>  // Für OQS_randombytes
 #include <sstream>
+#include <iomanip>
 
 #ifdef _WIN32
 #include <windows.h>
+#include <process.h>  // _getpid
 #include <intrin.h>
 #include <comdef.h>
 #include <Wbemidl.h>
 #pragma comment(lib, "wbemuuid.lib")
 #else
 #include <x86intrin.h>  // Für __rdtsc() auf Linux/Unix
+#include <cpuid.h>      // __cpuid
+#include <ctime>        // clock_gettime
+#include <unistd.h>     // getpid
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -50,13 +60,12 @@ namespace CronoUtils {
 
     uint64_t ram_fingerprint() {
         const size_t sample_size = 4096;
-        unsigned char* sample = new unsigned char[sample_size];
+        unsigned char sample[sample_size];
         OQS_randombytes(sample, sample_size);
         uint64_t result = 0;
         for (size_t i = 0; i < sample_size; i++) {
             result ^= static_cast<uint64_t>(sample[i]) << (i % 8);
         }
-        delete[] sample;
         return result;
     }
 
@@ -92,64 +101,66 @@ namespace CronoUtils {
         return walk;
     }
 
-    static uint64_t thread_binding_factor(double duration_ms) {
-        auto start = std::chrono::high_resolution_clock::now();
-        uint64_t local_factor = 1;
-        while (true) {
-            auto now = std::chrono::high_resolution_clock::now();
-            double elapsed = std::chrono::duration<double, std::milli>(now - start).count();
-            if (elapsed >= duration_ms)
-                break;
-            uint64_t sample_val = ram_fingerprint() ^ cache_noise();
-            local_factor *= (sample_val | 1);
-            for (volatile int j = 0; j < 50; j++) {}
-            local_factor %= 0xFFFFFFFFFFFFFDULL;
-        }
-        return local_factor;
-    }
-
     uint64_t adaptive_binding_factor(double duration_ms) {
-        unsigned int num_threads = std::thread::hardware_concurrency();
-        if (num_threads == 0)
-            num_threads = 1;
-        std::vector<uint64_t> results(num_threads, 1);
-        std::vector<std::thread> threads;
-        for (unsigned int i = 0; i < num_threads; i++) {
-            threads.emplace_back([&results, i, duration_ms]() {
-                results[i] = thread_binding_factor(duration_ms);
-                });
-        }
-        for (auto& t : threads) {
-            t.join();
-        }
-        uint64_t combined = 1;
-        for (auto val : results) {
-            combined *= (val | 1);
-            combined %= 0xFFFFFFFFFFFFFDULL;
-        }
-        return combined;
+        // Gleichzeitige Anfragen teilen sich ein Abtastfenster und einen Satz Sampler
+        return BindingScheduler::shared().bind(duration_ms);
     }
 
     uint64_t ghost_salt() {
         const size_t ghost_size = 2048;
-        unsigned char* ghost = new unsigned char[ghost_size];
+        unsigned char ghost[ghost_size];
         OQS_randombytes(ghost, ghost_size);
         uint64_t salt = 0;
         for (size_t i = 0; i < ghost_size; i++) {
             salt ^= static_cast<uint64_t>(ghost[i]) << (i % 8);
         }
-        delete[] ghost;
         return salt;
     }
 
+    long current_pid() {
 #ifdef _WIN32
-    // --- Windows-spezifische Hardware-Fingerprinting-Funktionen ---
+        return static_cast<long>(_getpid());
+#else
+        return static_cast<long>(getpid());
+#endif
+    }
+
+    static void cpuid(uint32_t leaf, uint32_t regs[4]) {
+#ifdef _WIN32
+        int info[4] = { 0 };
+        __cpuid(info, static_cast<int>(leaf));
+        for (int i = 0; i < 4; i++) {
+            regs[i] = static_cast<uint32_t>(info[i]);
+        }
+#else
+        __cpuid(leaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
     uint64_t get_cpu_id() {
-        int cpuInfo[4] = { 0 };
-        __cpuid(cpuInfo, 0);
-        return (static_cast<uint64_t>(cpuInfo[0]) << 32) | static_cast<uint64_t>(cpuInfo[1]);
+        // Herstellerkennung (Leaf 0), Signatur aus Familie/Modell/Stepping (Leaf 1, EAX) und Modellname
+        // (Leaves 0x80000002-4). EBX von Leaf 1 enthält die APIC-ID und hängt vom ausführenden Kern ab.
+        uint32_t words[16] = { 0 };
+        uint32_t regs[4];
+        cpuid(0, regs);
+        words[0] = regs[1];
+        words[1] = regs[3];
+        words[2] = regs[2];
+        if (regs[0] >= 1) {
+            cpuid(1, regs);
+            words[3] = regs[0];
+        }
+        cpuid(0x80000000, regs);
+        if (regs[0] >= 0x80000004) {
+            for (uint32_t leaf = 0; leaf < 3; leaf++) {
+                cpuid(0x80000002 + leaf, &words[4 + 4 * leaf]);
+            }
+        }
+        return mix_entropy(0, reinterpret_cast<const char*>(words), sizeof(words));
     }
 
+#ifdef _WIN32
+    // --- Windows-spezifische Hardware-Fingerprinting-Funktionen ---
     uint64_t tpm_fingerprint() {
         HRESULT hr = CoInitializeEx(0, COINIT_MULTITHREADED);
         if (FAILED(hr)) {
@@ -303,51 +314,21 @@ namespace CronoUtils {
         return biosFP;
     }
 
-    std::string generate_system_chain_id() {
-        // Windows-Version: Nutzt die oben definierten Funktionen
-        uint64_t cpuID = get_cpu_id();
-        uint64_t tpmFP = tpm_fingerprint();
-        uint64_t bootTime = os_boot_time();
-        uint64_t bios = bios_serial();
-        uint64_t ramFP = ram_fingerprint();
-        uint64_t chain = cpuID ^ tpmFP ^ bootTime ^ bios ^ ramFP;
-        for (int i = 0; i < 5; i++) {
-            chain = CronoMath::endomorph_transform(chain, get_tsc() ^ chain);
-        }
-        std::ostringstream oss;
-        oss << std::hex << std::setw(16) << std::setfill('0') << chain;
-        return oss.str();
-    }
-
 #else
     // --- Linux-spezifische Hardware-Fingerprinting-Funktionen ---
-    // Diese Implementierungen basieren auf dem Lesen von Systemdateien.
-    uint64_t get_cpu_id() {
-        std::ifstream cpuinfo("/proc/cpuinfo");
-        std::string line;
-        uint64_t id = 0;
-        while (std::getline(cpuinfo, line)) {
-            if (line.find("Serial") != std::string::npos ||
-                line.find("model name") != std::string::npos) {
-                std::hash<std::string> hash_fn;
-                id ^= hash_fn(line);
-            }
-        }
-        return id;
-    }
-
+    // Diese Implementierungen basieren auf dem Lesen von Systemdateien und Uhren.
     uint64_t os_boot_time() {
-        std::ifstream uptime_file("/proc/uptime");
-        std::string uptime_str;
-        if (std::getline(uptime_file, uptime_str)) {
-            std::istringstream iss(uptime_str);
-            double uptime;
-            iss >> uptime;
-            // Hier wird die System-Uptime (in Sekunden) zurückgegeben.
-            // Alternativ könnte man /proc/stat oder systemd-analyze nutzen.
-            return static_cast<uint64_t>(uptime * 1e9);
-        }
-        return 0;
+        // Wie unter Windows: aktuelle Systemzeit minus Laufzeit seit dem Start (inklusive Suspend)
+        timespec realtime{}, uptime{};
+        clock_gettime(CLOCK_REALTIME, &realtime);
+#ifdef CLOCK_BOOTTIME
+        clock_gettime(CLOCK_BOOTTIME, &uptime);
+#else
+        clock_gettime(CLOCK_MONOTONIC, &uptime);
+#endif
+        const uint64_t realtimeNS = static_cast<uint64_t>(realtime.tv_sec) * 1000000000ULL + static_cast<uint64_t>(realtime.tv_nsec);
+        const uint64_t uptimeNS = static_cast<uint64_t>(uptime.tv_sec) * 1000000000ULL + static_cast<uint64_t>(uptime.tv_nsec);
+        return realtimeNS - uptimeNS;
     }
 
     uint64_t bios_serial() {
@@ -361,13 +342,73 @@ namespace CronoUtils {
         return 0;
     }
 
+    // Wechselt mit jedem Systemstart
+    static uint64_t read_boot_id() {
+        std::ifstream boot_id_file("/proc/sys/kernel/random/boot_id");
+        std::string boot_id;
+        if (std::getline(boot_id_file, boot_id)) {
+            std::hash<std::string> hash_fn;
+            return hash_fn(boot_id);
+        }
+        return 0;
+    }
+#endif
+
+    // --- Momentaufnahme der Hardware-Merkmale (plattformübergreifend) ---
+
+    static constexpr uint64_t BOOT_ID_CHECK_INTERVAL_NS = 1000000000ULL;
+
+    static std::mutex fingerprintMutex;  // Serialisiert Neuberechnungen
+    static std::atomic<std::shared_ptr<const SystemFingerprint>> fingerprintSnapshot;
+    static std::atomic<uint64_t> nextBootIdCheck{ 0 };
+
+    static void recompute_fingerprint() {
+        std::lock_guard<std::mutex> lock(fingerprintMutex);
+        auto fingerprint = std::make_shared<SystemFingerprint>();
+        fingerprint->cpu_id = get_cpu_id();
+#ifdef _WIN32
+        fingerprint->tpm = tpm_fingerprint();
+#else
+        fingerprint->boot_id = read_boot_id();
+#endif
+        fingerprint->boot_time = os_boot_time();
+        fingerprint->bios = bios_serial();
+        auto previous = fingerprintSnapshot.load();
+        fingerprint->generation = previous ? previous->generation + 1 : 1;
+        fingerprintSnapshot.store(std::move(fingerprint));
+        nextBootIdCheck.store(get_steady_time() + BOOT_ID_CHECK_INTERVAL_NS);
+    }
+
+    static std::shared_ptr<const SystemFingerprint> current_fingerprint() {
+        static std::once_flag computed;
+        std::call_once(computed, recompute_fingerprint);
+        auto snapshot = fingerprintSnapshot.load();
+#ifndef _WIN32
+        // Nur ein Thread pro Intervall liest die Boot-ID; alle anderen verwenden die Momentaufnahme unverändert
+        uint64_t due = nextBootIdCheck.load(std::memory_order_relaxed);
+        const uint64_t now = get_steady_time();
+        if (now >= due && nextBootIdCheck.compare_exchange_strong(due, now + BOOT_ID_CHECK_INTERVAL_NS)) {
+            if (read_boot_id() != snapshot->boot_id) {
+                recompute_fingerprint();
+                snapshot = fingerprintSnapshot.load();
+            }
+        }
+#endif
+        return snapshot;
+    }
+
+    SystemFingerprint system_fingerprint() {
+        return *current_fingerprint();
+    }
+
+    void refresh_system_fingerprint() {
+        current_fingerprint();  // Erste Erhebung abschließen, damit die Zählung fortlaufend bleibt
+        recompute_fingerprint();
+    }
+
     std::string generate_system_chain_id() {
-        // Linux-Version: Nutzt alternative Methoden für Hardware-Fingerprinting
-        uint64_t cpuID = get_cpu_id();
-        uint64_t bootTime = os_boot_time();
-        uint64_t bios = bios_serial();
-        uint64_t ramFP = ram_fingerprint();
-        uint64_t chain = cpuID ^ bootTime ^ bios ^ ramFP;
+        const auto fingerprint = current_fingerprint();
+        uint64_t chain = fingerprint->cpu_id ^ fingerprint->tpm ^ fingerprint->boot_time ^ fingerprint->bios ^ ram_fingerprint();
         for (int i = 0; i < 5; i++) {
             chain = CronoMath::endomorph_transform(chain, get_tsc() ^ chain);
         }
@@ -375,6 +416,5 @@ namespace CronoUtils {
         oss << std::hex << std::setw(16) << std::setfill('0') << chain;
         return oss.str();
     }
-#endif
 
 } // namespace CronoUtils
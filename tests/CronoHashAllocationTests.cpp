@@ -0,0 +1,133 @@
+﻿// CronoHashAllocationTests.cpp
+// Ersetzt die globalen operator new/delete durch zählende Varianten. Die Datei gehört nur zum Test-Binary
+// und bleibt bewusst außerhalb von CronoHash.vcxproj, damit die Ersetzung nicht in die CLI gelangt.
+#include <gtest/gtest.h>
+#include "../include/crono_hash.h"
+#include "../include/crono_arena.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Zählt die Heap-Anforderungen des aktuellen Threads, solange countAllocations gesetzt ist; Hintergrund-Threads
+// anderer Tests (Pools, Kapselungs-Ring) zählen dadurch nicht mit
+static thread_local bool countAllocations = false;
+static thread_local std::size_t allocationCount = 0;
+
+static void* counted_allocate(std::size_t size) {
+    if (countAllocations)
+        allocationCount++;
+    return std::malloc(size ? size : 1);
+}
+
+static void* counted_allocate(std::size_t size, std::align_val_t alignment) {
+    if (countAllocations)
+        allocationCount++;
+    const std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    void* p = nullptr;
+    return posix_memalign(&p, align < sizeof(void*) ? sizeof(void*) : align, size ? size : 1) == 0 ? p : nullptr;
+#endif
+}
+
+static void counted_free(void* p) noexcept {
+    std::free(p);
+}
+
+static void counted_free(void* p, std::align_val_t) noexcept {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = counted_allocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = counted_allocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = counted_allocate(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = counted_allocate(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_allocate(size, alignment); }
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t alignment) noexcept { counted_free(p, alignment); }
+void operator delete[](void* p, std::align_val_t alignment) noexcept { counted_free(p, alignment); }
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept { counted_free(p, alignment); }
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept { counted_free(p, alignment); }
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept { counted_free(p, alignment); }
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept { counted_free(p, alignment); }
+
+// Test: Nach dem Aufwärmen fordert Hasher::hash_into() über keinen Weg mehr Heap-Speicher an
+TEST(CronoHashAllocationTest, SteadyStateHashIntoAllocatesNothing) {
+    CronoHash::Hasher v3(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3);
+    CronoHash::Hasher v1(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V1);
+    std::string input = "ZeroAllocationInput";
+    std::string large(1000, 'x');  // V1: Quantum-Puffer größer als der Stack-Puffer -> Thread-Arena
+    std::byte out[4096 / 8];
+
+    auto run = [&]() {
+        v3.hash_into(out, input.c_str(), input.length(), 0, CronoHash::CronoMode::BALANCED, 256);
+        v3.hash_into(out, large.c_str(), large.length(), 0, CronoHash::CronoMode::SECURE, 4096);
+        v3.hash_into(out, large.c_str(), large.length(), 0, CronoHash::CronoMode::ENTROPIC, 1024);
+        v1.hash_into(out, large.c_str(), large.length(), 0, CronoHash::CronoMode::FAST, 512);
+    };
+    allocationCount = 0;
+    countAllocations = true;
+    for (int i = 0; i < 4; i++) run();
+    countAllocations = false;
+    // Das Aufwärmen legt Sitzung und Arena an; ohne Zählung hier wäre die Ersetzung nicht wirksam
+    EXPECT_GT(allocationCount, 0u);
+
+    // 200 Durchläufe schließen mehrere Kyber-Schlüsselwechsel ein
+    allocationCount = 0;
+    countAllocations = true;
+    for (int i = 0; i < 200; i++) run();
+    countAllocations = false;
+
+    EXPECT_EQ(allocationCount, 0u);
+    EXPECT_EQ(CronoUtils::thread_arena().used(), 0u);
+}
+
+// Test: Stream::final_into() schreibt direkt nach out und fordert nach dem Aufwärmen keinen Speicher an
+TEST(CronoHashAllocationTest, SteadyStateStreamFinalIntoAllocatesNothing) {
+    CronoHash::Stream stream(0, CronoHash::CronoMode::SECURE, 2048);
+    std::string chunk(4096, 's');
+    std::byte out[2048 / 8];
+
+    auto run = [&]() {
+        stream.update(chunk.c_str(), chunk.length());
+        stream.final_into(out);
+    };
+    for (int i = 0; i < 4; i++) run();
+
+    allocationCount = 0;
+    countAllocations = true;
+    for (int i = 0; i < 100; i++) run();
+    countAllocations = false;
+
+    EXPECT_EQ(allocationCount, 0u);
+}
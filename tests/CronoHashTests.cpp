@@ -1,9 +1,34 @@
 ﻿// CronoHashTests.cpp
 #include <gtest/gtest.h>
 #include "../include/crono_hash.h"
+#include "../include/crono_math.h"
+#include "../include/crono_quantum.h"
+#include "../include/crono_arena.h"
+#include "../include/crono_pool.h"
+#include "../include/crono_binding.h"
+#include "../include/crono_drbg.h"
+#include "../include/crono_file.h"
+#include "../include/crono_utils.h"
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <random>
+#include <bit>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <cstdlib>
+#include <memory_resource>
+#include <oqs/oqs.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 // Test: 128-Bit Hash im BALANCED-Modus
 TEST(CronoHashTest, Hash128Balanced) {
@@ -41,13 +66,21 @@ TEST(CronoHashTest, TimeBindingHashDiffers) {
     std::cout << "[TimeBindingHashDiffers] Hash1: " << hash1 << "\nHash2: " << hash2 << std::endl;
 }
 
-// Test: Ohne Zeitbindung sollten Hashes deterministisch sein
+// Test: Ohne Zeitbindung und mit festen Uhren/Entropiequellen sollten Hashes deterministisch sein
 TEST(CronoHashTest, DeterministicNoBinding) {
     std::string input = "StableInput123";
-    auto hash1 = CronoHash::hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256);
-    auto hash2 = CronoHash::hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256);
+    CronoEntropy::FixedClock clock1(1, 2, 3), clock2(1, 2, 3);
+    CronoEntropy::FixedSeedEntropy entropy1(42), entropy2(42);
+    CronoHash::Hasher hasher1({}, CronoHash::CronoVersion::V2, { &clock1, &entropy1 });
+    CronoHash::Hasher hasher2({}, CronoHash::CronoVersion::V2, { &clock2, &entropy2 });
+    auto hash1 = hasher1.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256);
+    auto hash2 = hasher2.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256);
     EXPECT_EQ(hash1, hash2);
     std::cout << "[DeterministicNoBinding] Hash: " << hash1 << std::endl;
+
+    CronoEntropy::FixedSeedEntropy other(43);
+    CronoHash::Hasher hasher3({}, CronoHash::CronoVersion::V2, { &clock1, &other });
+    EXPECT_NE(hasher3.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256), hash1);
 }
 
 // Test: Überprüfung der Metadaten-Ausgabe
@@ -89,3 +122,1073 @@ TEST(CronoHashTest, DifferentModes) {
     }
 }
 
+
+// Test: Wiederverwendbarer Hasher-Kontext liefert korrekte Längen und zählt Aufrufe
+TEST(CronoHashTest, HasherReusesEnvironment) {
+    std::string input = "HasherInput";
+    CronoHash::Hasher hasher;
+    for (int i = 0; i < 5; i++) {
+        auto hash = hasher.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::BALANCED, 512);
+        EXPECT_EQ(hash.length(), 128);
+    }
+    EXPECT_EQ(hasher.hashes_since_refresh(), 5u);
+    hasher.refresh();
+    EXPECT_EQ(hasher.hashes_since_refresh(), 0u);
+}
+
+// Zählt, wie oft die Umgebungsquellen eines Hashers gelesen werden; die Werte stammen aus FixedSeedEntropy
+class CountingEntropy final : public CronoEntropy::EntropyProvider {
+public:
+    explicit CountingEntropy(uint64_t seed) : inner_(seed) {}
+    void random_bytes(uint8_t* out, std::size_t length) override { inner_.random_bytes(out, length); }
+    uint64_t ram_fingerprint() override { ram++; return inner_.ram_fingerprint(); }
+    uint64_t cache_noise() override { cache++; return inner_.cache_noise(); }
+    uint64_t ghost_salt() override { ghost++; return inner_.ghost_salt(); }
+    uint64_t memory_walk() override { return inner_.memory_walk(); }
+    uint64_t binding_factor(double duration_ms) override { return inner_.binding_factor(duration_ms); }
+
+    int ram = 0, cache = 0, ghost = 0;
+
+private:
+    CronoEntropy::FixedSeedEntropy inner_;
+};
+
+// Test: RefreshPolicy erneuert die Entropie nach N Hashes
+TEST(CronoHashTest, HasherRefreshEveryN) {
+    std::string input = "RefreshInput";
+    CronoHash::RefreshPolicy policy;
+    policy.every_n_hashes = 3;
+    CronoEntropy::FixedClock clock(1, 2, 3);
+    CountingEntropy entropy(11);
+    CronoHash::Hasher hasher(policy, CronoHash::CronoVersion::V3, { &clock, &entropy });
+    EXPECT_EQ(entropy.ram, 1);  // Erhebung im Konstruktor
+
+    // Die Umgebungsquellen werden genau einmal pro N Hashes gelesen, dazwischen wiederverwendet
+    const int expected[7] = { 1, 1, 1, 2, 2, 2, 3 };
+    for (int i = 0; i < 7; i++) {
+        hasher.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256);
+        EXPECT_EQ(entropy.ram, expected[i]) << "nach Hash " << i + 1;
+        EXPECT_EQ(entropy.cache, expected[i]) << "nach Hash " << i + 1;
+        EXPECT_EQ(entropy.ghost, expected[i]) << "nach Hash " << i + 1;
+    }
+    // 3 + 3 + 1: nach dem zweiten Refresh wurde genau ein Hash berechnet
+    EXPECT_EQ(hasher.hashes_since_refresh(), 1u);
+
+    // Ein expliziter Refresh liest sofort neu
+    hasher.refresh();
+    EXPECT_EQ(entropy.ram, 4);
+    EXPECT_EQ(hasher.hashes_since_refresh(), 0u);
+}
+
+// Test: Binäre Digest-Ausgabe und CronoDigest-Werttyp
+TEST(CronoHashTest, BinaryDigestApi) {
+    std::string input = "DigestInput";
+    EXPECT_EQ(CronoHash::digest_size(1024), 128u);
+
+    std::byte small[16];
+    EXPECT_EQ(CronoHash::hash_into(small, input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256), 0u);
+
+    std::byte out[32];
+    EXPECT_EQ(CronoHash::hash_into(out, input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256), 32u);
+    EXPECT_EQ(CronoHash::to_hex(out).length(), 64u);
+
+    auto d1 = CronoHash::digest<256>(input.c_str(), input.length());
+    auto d2 = d1;
+    EXPECT_EQ(d1, d2);
+    d2.bytes[31] ^= std::byte{ 1 };
+    EXPECT_NE(d1, d2);
+    EXPECT_EQ(d1 < d2, d1.to_hex() < d2.to_hex());
+
+    std::unordered_map<CronoHash::CronoDigest<256>, int> map;
+    map[d1] = 1;
+    map[d2] = 2;
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(map[d1], 1);
+}
+
+// Test: HashResult enthält exakt die Werte eines einzigen Durchlaufs
+TEST(CronoHashTest, HashResultSinglePass) {
+    std::string input = "ResultInput";
+    auto result = CronoHash::hash_with_result(input.c_str(), input.length(), 50, CronoHash::CronoMode::SECURE, 512);
+    EXPECT_EQ(result.digest.size(), 64u);
+    EXPECT_EQ(result.hex().length(), 128u);
+    EXPECT_NE(result.binding_factor, 0u);
+    EXPECT_NE(result.tsc, 0u);
+    EXPECT_EQ(result.mode, CronoHash::CronoMode::SECURE);
+    EXPECT_EQ(result.bit_strength, 512u);
+
+    auto json = CronoHash::to_json(result);
+    EXPECT_NE(json.find("\"hash\": \"" + result.hex() + "\""), std::string::npos);
+    EXPECT_NE(json.find("\"tsc\": " + std::to_string(result.tsc)), std::string::npos);
+}
+
+// Liefert stets denselben Bindungsfaktor, ohne den Strom weiterzuschalten: hash_batch() zieht ihn einmal
+// für den Batch, ein sequentieller Hasher einmal pro Hash, beide sehen so dieselben Werte
+class SharedBindingEntropy final : public CronoEntropy::EntropyProvider {
+public:
+    explicit SharedBindingEntropy(uint64_t seed) : inner_(seed) {}
+    void random_bytes(uint8_t* out, std::size_t length) override { inner_.random_bytes(out, length); }
+    uint64_t ram_fingerprint() override { return inner_.ram_fingerprint(); }
+    uint64_t cache_noise() override { return inner_.cache_noise(); }
+    uint64_t ghost_salt() override { return inner_.ghost_salt(); }
+    uint64_t memory_walk() override { return inner_.memory_walk(); }
+    uint64_t binding_factor(double) override { return 0xB1D1B1D1B1D1B1D1ULL; }
+
+private:
+    CronoEntropy::FixedSeedEntropy inner_;
+};
+
+// Test: Batch-Hashing schreibt Digest i in Slot i, genau wie ein sequentieller Hasher mit denselben Quellen
+TEST(CronoHashTest, BatchHashing) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 100; i++) {
+        storage.push_back("BatchInput" + std::to_string(i));
+    }
+    std::vector<std::string_view> inputs(storage.begin(), storage.end());
+
+    CronoHash::BatchOptions options;
+    options.binding_duration_ms = 5.0;
+    options.mode = CronoHash::CronoMode::SECURE;
+    options.bit_strength = 512;
+    options.num_threads = 1;
+    const std::size_t size = CronoHash::digest_size(options.bit_strength);
+
+    CronoEntropy::FixedClock clock_batch(1, 2, 3), clock_sequential(1, 2, 3);
+    SharedBindingEntropy entropy_batch(21), entropy_sequential(21);
+    CronoHash::Hasher batch(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3, { &clock_batch, &entropy_batch });
+    CronoHash::Hasher sequential(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3, { &clock_sequential, &entropy_sequential });
+
+    std::vector<std::byte> too_small(size * inputs.size() - 1);
+    EXPECT_EQ(batch.hash_batch(inputs, too_small, options), 0u);
+    EXPECT_EQ(batch.hashes_since_refresh(), 0u);
+
+    std::vector<std::byte> out(size * inputs.size());
+    ASSERT_EQ(batch.hash_batch(inputs, out, options), inputs.size());
+    std::vector<std::string> slots;
+    std::vector<std::byte> expected(size);
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        std::span<const std::byte> slot(out.data() + i * size, size);
+        ASSERT_EQ(sequential.hash_into(expected, inputs[i].data(), inputs[i].size(), options.binding_duration_ms, options.mode, options.bit_strength), size);
+        EXPECT_TRUE(std::equal(slot.begin(), slot.end(), expected.begin())) << "Slot " << i;
+        slots.push_back(CronoHash::to_hex(slot));
+    }
+    // Verschiedene Eingaben landen in verschiedenen Slots
+    std::sort(slots.begin(), slots.end());
+    EXPECT_EQ(std::adjacent_find(slots.begin(), slots.end()), slots.end());
+
+    // Freie Funktion mit Produktionsquellen und mehreren Threads: gleiche Größenprüfung, alle Slots beschrieben
+    options.num_threads = 4;
+    options.binding_duration_ms = 0.0;
+    EXPECT_EQ(CronoHash::hash_batch(inputs, too_small, options), 0u);
+    EXPECT_EQ(CronoHash::hash_batch(inputs, out, options), inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        std::span<const std::byte> digest(out.data() + i * size, size);
+        bool all_zero = std::all_of(digest.begin(), digest.end(), [](std::byte b) { return b == std::byte{ 0 }; });
+        EXPECT_FALSE(all_zero) << "Digest " << i << " wurde nicht geschrieben";
+    }
+}
+
+// Test: Streaming-Hash über mehrere Chunks
+TEST(CronoHashTest, StreamingChunks) {
+    std::string chunk(4096, 'x');
+    CronoHash::Stream stream(0, CronoHash::CronoMode::BALANCED, 1024);
+    for (int i = 0; i < 256; i++) {
+        stream.update(chunk.c_str(), chunk.length());
+    }
+    EXPECT_EQ(stream.bytes_absorbed(), 256u * 4096u);
+    auto result = stream.final();
+    EXPECT_EQ(result.digest.size(), 128u);
+    EXPECT_EQ(result.bit_strength, 1024u);
+    // Nach final() ist der Stream zurückgesetzt
+    EXPECT_EQ(stream.bytes_absorbed(), 0u);
+
+    std::byte out[128];
+    stream.update(chunk.c_str(), 10);
+    EXPECT_EQ(stream.final_into(std::span<std::byte>(out, 127)), 0u);
+    EXPECT_EQ(stream.bytes_absorbed(), 10u);
+    EXPECT_EQ(stream.final_into(out), 128u);
+    EXPECT_EQ(stream.bytes_absorbed(), 0u);
+
+    // final_into() und final() liefern bei festen Quellen denselben Digest
+    CronoEntropy::FixedClock clock_a(4, 5, 6), clock_b(4, 5, 6);
+    CronoEntropy::FixedSeedEntropy entropy_a(13), entropy_b(13);
+    CronoHash::Stream raw(2.0, CronoHash::CronoMode::ENTROPIC, 1024, { &clock_a, &entropy_a });
+    CronoHash::Stream full(2.0, CronoHash::CronoMode::ENTROPIC, 1024, { &clock_b, &entropy_b });
+    raw.update(chunk.c_str(), chunk.length());
+    full.update(chunk.c_str(), chunk.length());
+    ASSERT_EQ(raw.final_into(out), 128u);
+    auto full_result = full.final();
+    EXPECT_TRUE(std::equal(full_result.digest.begin(), full_result.digest.end(), out));
+    EXPECT_EQ(full_result.version, CronoHash::CronoVersion::V3);
+    EXPECT_NE(full_result.binding_factor, 0u);
+}
+
+// Test: Versionierte Konstruktion – V2 absorbiert die Eingabe einmal, V1 bleibt wählbar
+TEST(CronoHashTest, VersionedConstruction) {
+    std::string input(1 << 20, 'v');
+    CronoHash::Hasher v1({}, CronoHash::CronoVersion::V1);
+    CronoHash::Hasher v2({}, CronoHash::CronoVersion::V2);
+    // Ohne gewählte Version V1 wie hash(); nur Ergebnisse mit Versionsfeld nutzen ohne Angabe V3
+    EXPECT_EQ(CronoHash::Hasher().version(), CronoHash::CronoVersion::V1);
+    EXPECT_EQ(CronoHash::hash_with_result(input.c_str(), 64).version, CronoHash::CronoVersion::V3);
+
+    auto r1 = v1.hash_with_result(input.c_str(), 4096, 0, CronoHash::CronoMode::BALANCED, 256);
+    auto r2 = v2.hash_with_result(input.c_str(), input.length(), 0, CronoHash::CronoMode::BALANCED, 2048);
+    EXPECT_EQ(r1.version, CronoHash::CronoVersion::V1);
+    EXPECT_EQ(r2.version, CronoHash::CronoVersion::V2);
+    EXPECT_EQ(r2.digest.size(), 256u);
+    EXPECT_NE(CronoHash::to_json(r1).find("\"version\": 1"), std::string::npos);
+    EXPECT_NE(CronoHash::to_json(r2).find("\"version\": 2"), std::string::npos);
+    // Die Legacy-Funktionen ohne Versionsangabe im Hex-String bleiben bei V1
+    EXPECT_NE(CronoHash::hash_with_metadata(input.c_str(), 4096).find("\"version\": 1"), std::string::npos);
+
+    // V3 und Stream: dieselbe Konstruktion, bei festen Quellen also derselbe Digest
+    CronoEntropy::FixedClock clock1(5, 6, 7), clock2(5, 6, 7);
+    CronoEntropy::FixedSeedEntropy entropy1(9), entropy2(9);
+    CronoHash::Hasher v3({}, CronoHash::CronoVersion::V3, { &clock1, &entropy1 });
+    auto r3 = v3.hash_with_result(input.c_str(), input.length(), 0, CronoHash::CronoMode::SECURE, 512);
+    EXPECT_EQ(r3.version, CronoHash::CronoVersion::V3);
+
+    CronoHash::Stream stream(0, CronoHash::CronoMode::SECURE, 512, { &clock2, &entropy2 });
+    for (std::size_t offset = 0; offset < input.length(); offset += 65537) {
+        stream.update(input.c_str() + offset, std::min<std::size_t>(65537, input.length() - offset));
+    }
+    auto streamed = stream.final();
+    EXPECT_EQ(streamed.version, CronoHash::CronoVersion::V3);
+    EXPECT_EQ(streamed.hex(), r3.hex());
+
+    // Verschiebende Zuweisung übernimmt die absorbierte Länge (Teil der V3-Ableitung)
+    CronoQuantum::AbsorbedInput absorbed, target;
+    absorbed.absorb(input.data(), 4096);
+    target.absorb("x", 1);
+    target = std::move(absorbed);
+    EXPECT_EQ(target.absorbed(), 4096u);
+    EXPECT_EQ(absorbed.absorbed(), 0u);
+
+    // Verschobene Objekte (Konstruktor und Zuweisung) bleiben benutzbar und verhalten sich wie frische
+    CronoQuantum::AbsorbedInput constructed(std::move(target)), fresh;
+    EXPECT_EQ(constructed.absorbed(), 4096u);
+    EXPECT_EQ(target.absorbed(), 0u);
+    uint8_t derived_moved[32], derived_fresh[32];
+    for (CronoQuantum::AbsorbedInput* moved : { &absorbed, &target }) {
+        moved->reset();
+        moved->absorb("abc", 3);
+        fresh.reset();
+        fresh.absorb("abc", 3);
+        EXPECT_EQ(moved->absorbed(), 3u);
+        moved->derive(&CronoQuantum::QUANTUM_MIX_TAG, 1, derived_moved, sizeof(derived_moved));
+        fresh.derive(&CronoQuantum::QUANTUM_MIX_TAG, 1, derived_fresh, sizeof(derived_fresh));
+        EXPECT_EQ(std::memcmp(derived_moved, derived_fresh, sizeof(derived_fresh)), 0);
+    }
+    CronoQuantum::AbsorbedInput derive_only(std::move(constructed));
+    constructed.derive(&CronoQuantum::QUANTUM_MIX_TAG, 1, derived_moved, sizeof(derived_moved));
+    CronoQuantum::AbsorbedInput empty;
+    empty.derive(&CronoQuantum::QUANTUM_MIX_TAG, 1, derived_fresh, sizeof(derived_fresh));
+    EXPECT_EQ(std::memcmp(derived_moved, derived_fresh, sizeof(derived_fresh)), 0);
+}
+
+// Test: SIMD-Wortkernel liefern bitgenau dieselben Ergebnisse wie die skalaren Funktionen
+TEST(CronoHashTest, SimdKernelsMatchScalar) {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> input(37);  // keine Vielfache von 4/8, damit auch der skalare Rest geprüft wird
+    for (auto& w : input) w = rng();
+    input[0] = 0;
+    input[1] = ~0ULL;
+
+    const CronoMath::SimdLevel original = CronoMath::simd_level();
+    for (auto level : { CronoMath::SimdLevel::Scalar, CronoMath::SimdLevel::AVX2, CronoMath::SimdLevel::AVX512 }) {
+        if (!CronoMath::force_simd_level(level))
+            continue;
+        const uint64_t seed = rng();
+
+        std::vector<uint64_t> words = input;
+        CronoMath::endomorph_transform_words(words.data(), words.size(), seed);
+        for (std::size_t i = 0; i < words.size(); i++)
+            EXPECT_EQ(words[i], CronoMath::endomorph_transform(input[i], seed)) << "endomorph, Level " << static_cast<int>(level);
+
+        words = input;
+        CronoMath::hash_const_mix_words(words.data(), words.size());
+        for (std::size_t i = 0; i < words.size(); i++)
+            EXPECT_EQ(words[i], CronoMath::hash_const_mix(input[i])) << "const_mix, Level " << static_cast<int>(level);
+
+        words = input;
+        CronoMath::mod_prime256_words(words.data(), words.size());
+        for (std::size_t i = 0; i < words.size(); i++)
+            EXPECT_EQ(words[i], CronoMath::mod_prime256(input[i], static_cast<int>(i % 4))) << "mod_prime256, Level " << static_cast<int>(level);
+    }
+
+    // Umschalten während laufender Berechnungen: jede Variante liefert dasselbe Ergebnis
+    std::atomic<bool> done{ false };
+    std::thread toggler([&]() {
+        while (!done.load()) {
+            CronoMath::force_simd_level(CronoMath::SimdLevel::Scalar);
+            CronoMath::force_simd_level(original);
+        }
+    });
+    const uint64_t seed = rng();
+    int mismatches = 0;
+    for (int round = 0; round < 2000; round++) {
+        std::vector<uint64_t> words = input;
+        CronoMath::endomorph_transform_words(words.data(), words.size(), seed);
+        mismatches += words[5] != CronoMath::endomorph_transform(input[5], seed);
+    }
+    done = true;
+    toggler.join();
+    EXPECT_EQ(mismatches, 0);
+    CronoMath::force_simd_level(original);
+}
+
+// Test: Reduktion per Reziprokwert entspricht dem Modulo-Operator für alle Tabellenprimzahlen und Randwerte
+TEST(CronoHashTest, ReciprocalReductionMatchesModulo) {
+    std::vector<uint64_t> divisors(CronoMath::PRIMES, CronoMath::PRIMES + CronoMath::NUM_PRIMES);
+    divisors.insert(divisors.end(), CronoMath::EXTRA_PRIMES, CronoMath::EXTRA_PRIMES + CronoMath::NUM_EXTRA_PRIMES);
+    divisors.insert(divisors.end(), { 1ULL, 2ULL, 3ULL, 7ULL, (1ULL << 63) - 1, 1ULL << 63, ~0ULL - 1, ~0ULL });
+
+    // Leere Tabelleneinträge (0) werden wie bisher als Divisor 1 behandelt
+    auto effective = [](uint64_t p) { return p == 0 ? 1 : p; };
+    std::replace(divisors.begin(), divisors.end(), 0ULL, 1ULL);
+
+    std::mt19937_64 rng(7);
+    for (uint64_t p : divisors) {
+        const CronoMath::Reciprocal r = CronoMath::make_reciprocal(p);
+        std::vector<uint64_t> inputs = { 0, 1, p - 1, p, p + 1, 2 * p - 1, 2 * p, ~0ULL, ~0ULL - 1, 1ULL << 63 };
+        // Ränder um Vielfache des Divisors über den gesamten Wertebereich
+        const uint64_t kmax = ~0ULL / p;
+        for (uint64_t k = 1; k <= kmax / 3; k = k * 3 + 1) {
+            inputs.push_back(k * p - 1);
+            inputs.push_back(k * p);
+            inputs.push_back(k * p + 1);
+        }
+        inputs.push_back(kmax * p);
+        inputs.push_back(kmax * p - 1);
+        for (int i = 0; i < 20000; i++)
+            inputs.push_back(rng() >> (i % 64));
+
+        for (uint64_t x : inputs)
+            ASSERT_EQ(CronoMath::reduce(x, r), x % p) << "x=" << x << " p=" << p;
+    }
+
+    // Die öffentlichen Funktionen verwenden dieselben Tabellen wie vorher
+    for (int i = 0; i < 100000; i++) {
+        const uint64_t x = rng() >> (i % 64);
+        ASSERT_EQ(CronoMath::mod_prime(x), x % effective(CronoMath::PRIMES[x % CronoMath::NUM_PRIMES]));
+        const int index = i % 8;
+        ASSERT_EQ(CronoMath::mod_prime256(x, index), std::rotl(x, (index * 11) % 64) % CronoMath::EXTRA_PRIMES[index]);
+    }
+}
+
+// Test: Aufgezeichnete Uhr- und Entropiewerte reproduzieren einen Produktions-Hash
+TEST(CronoHashTest, RecordAndReplay) {
+    std::string input = "ReplayInput";
+    CronoEntropy::Recording recording;
+    CronoEntropy::RecordingClock recording_clock(CronoEntropy::production_clock(), recording);
+    CronoEntropy::RecordingEntropy recording_entropy(CronoEntropy::production_entropy(), recording);
+    CronoHash::HashResult recorded;
+    {
+        CronoHash::Hasher hasher({}, CronoHash::CronoVersion::V2, { &recording_clock, &recording_entropy });
+        recorded = hasher.hash_with_result(input.c_str(), input.length(), 5, CronoHash::CronoMode::ENTROPIC, 512);
+    }
+    EXPECT_GT(recording.byte_count(), 0u);  // Kyber-Zufälligkeit wurde mitgeschnitten
+
+    // Über das Textformat, wie beim Übertragen eines Produktionsfalls
+    CronoEntropy::Recording loaded;
+    ASSERT_TRUE(loaded.from_text(recording.to_text()));
+    EXPECT_EQ(loaded.value_count(), recording.value_count());
+    EXPECT_EQ(loaded.byte_count(), recording.byte_count());
+    EXPECT_FALSE(loaded.from_text("kein mitschnitt"));
+
+    CronoEntropy::ReplayClock replay_clock(loaded);
+    CronoEntropy::ReplayEntropy replay_entropy(loaded);
+    CronoHash::Hasher replayer({}, CronoHash::CronoVersion::V2, { &replay_clock, &replay_entropy });
+    auto replayed = replayer.hash_with_result(input.c_str(), input.length(), 5, CronoHash::CronoMode::ENTROPIC, 512);
+    EXPECT_EQ(replayed.hex(), recorded.hex());
+    EXPECT_EQ(replayed.tsc, recorded.tsc);
+    EXPECT_EQ(replayed.binding_factor, recorded.binding_factor);
+    EXPECT_FALSE(loaded.exhausted());
+}
+
+// Test: Die Kyber-Sitzung wechselt ihr Schlüsselpaar nach der eingestellten Anzahl Kapselungen
+TEST(CronoHashTest, KyberSessionRotatesKey) {
+    CronoQuantum::KyberSession session(4);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_NE(session.encapsulate(), nullptr);
+    }
+    EXPECT_EQ(session.encapsulations(), 10u);
+    EXPECT_EQ(session.rotations(), 3u);  // Schlüssel für Kapselung 1, 5 und 9
+
+    // Ein Wechsel der Zufallsquelle erzwingt einen neuen Schlüssel
+    CronoEntropy::FixedSeedEntropy entropy(1);
+    {
+        CronoEntropy::ScopedRandomSource source(entropy);
+        ASSERT_NE(session.encapsulate(), nullptr);
+    }
+    EXPECT_EQ(session.rotations(), 4u);
+
+    // Die Pipeline nutzt die Sitzung des Threads: ein Wort = eine Kapselung
+    auto& thread_session = CronoQuantum::KyberSession::for_this_thread();
+    const uint64_t before = thread_session.encapsulations();
+    std::string input = "SessionInput";
+    CronoHash::Hasher hasher({}, CronoHash::CronoVersion::V3);
+    hasher.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 512);
+    EXPECT_EQ(thread_session.encapsulations() - before, 8u);
+}
+
+// Test: Derandomisierte Kapselung ist bei gleichen Coins deterministisch
+TEST(CronoHashTest, DerandomizedEncapsulation) {
+    CronoQuantum::KyberSession session(100);
+    uint8_t coins_a[CronoQuantum::KyberSession::COIN_BYTES];
+    uint8_t coins_b[CronoQuantum::KyberSession::COIN_BYTES];
+    for (size_t i = 0; i < sizeof(coins_a); i++) {
+        coins_a[i] = static_cast<uint8_t>(i);
+        coins_b[i] = static_cast<uint8_t>(i + 1);
+    }
+
+    // Zufallsbytes mitschneiden: nur der Schlüsselwechsel darf welche ziehen (64 Byte Keypair-Seed)
+    CronoEntropy::FixedSeedEntropy inner(3);
+    CronoEntropy::Recording recording;
+    CronoEntropy::RecordingEntropy entropy(inner, recording);
+    CronoEntropy::ScopedRandomSource source(entropy);
+
+    std::vector<uint8_t> first(session.shared_secret_length());
+    const uint8_t* ss = session.encapsulate(coins_a);
+    ASSERT_NE(ss, nullptr);
+    std::memcpy(first.data(), ss, first.size());
+    for (int i = 0; i < 10; i++) {
+        ss = session.encapsulate(coins_a);
+        ASSERT_NE(ss, nullptr);
+        EXPECT_EQ(std::memcmp(first.data(), ss, first.size()), 0);  // Gleiche Coins, gleicher Schlüssel
+    }
+    ss = session.encapsulate(coins_b);
+    ASSERT_NE(ss, nullptr);
+    EXPECT_NE(std::memcmp(first.data(), ss, first.size()), 0);
+    EXPECT_EQ(session.rotations(), 1u);
+    EXPECT_EQ(recording.byte_count(), 64u);
+}
+
+// Interne Einstiegspunkte der vendorten Kyber512-Implementierungen; OQS_KEM_kyber_512_* wählt nur eine davon
+extern "C" {
+    int pqcrystals_kyber512_ref_keypair_derand(uint8_t* pk, uint8_t* sk, const uint8_t* coins);
+    int pqcrystals_kyber512_ref_enc_derand(uint8_t* ct, uint8_t* ss, const uint8_t* pk, const uint8_t* coins);
+    int pqcrystals_kyber512_ref_expand_pk(uint8_t* epk, const uint8_t* pk);
+    int pqcrystals_kyber512_ref_enc_expanded_derand(uint8_t* ct, uint8_t* ss, const uint8_t* epk, const uint8_t* coins);
+    int pqcrystals_kyber512_ref_dec(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
+#ifdef OQS_ENABLE_KEM_kyber_512_avx2
+    int pqcrystals_kyber512_avx2_keypair_derand(uint8_t* pk, uint8_t* sk, const uint8_t* coins);
+    int pqcrystals_kyber512_avx2_enc_derand(uint8_t* ct, uint8_t* ss, const uint8_t* pk, const uint8_t* coins);
+    int pqcrystals_kyber512_avx2_expand_pk(uint8_t* epk, const uint8_t* pk);
+    int pqcrystals_kyber512_avx2_enc_expanded_derand(uint8_t* ct, uint8_t* ss, const uint8_t* epk, const uint8_t* coins);
+    int pqcrystals_kyber512_avx2_dec(uint8_t* ss, const uint8_t* ct, const uint8_t* sk);
+#endif
+}
+
+// Test: Kapselung gegen den vorab expandierten Schlüssel ist bitgenau gleich encaps_derand (ref, AVX2 und öffentliche API)
+TEST(CronoHashTest, ExpandedEncapsulationMatchesDerand) {
+    struct Implementation {
+        const char* name;
+        int (*keypair)(uint8_t*, uint8_t*, const uint8_t*);
+        int (*enc)(uint8_t*, uint8_t*, const uint8_t*, const uint8_t*);
+        int (*expand)(uint8_t*, const uint8_t*);
+        int (*enc_expanded)(uint8_t*, uint8_t*, const uint8_t*, const uint8_t*);
+        int (*dec)(uint8_t*, const uint8_t*, const uint8_t*);
+    };
+    auto oqs_keypair = [](uint8_t* pk, uint8_t* sk, const uint8_t* coins) { return static_cast<int>(OQS_KEM_kyber_512_keypair_derand(pk, sk, coins)); };
+    auto oqs_enc = [](uint8_t* ct, uint8_t* ss, const uint8_t* pk, const uint8_t* coins) { return static_cast<int>(OQS_KEM_kyber_512_encaps_derand(ct, ss, pk, coins)); };
+    auto oqs_expand = [](uint8_t* epk, const uint8_t* pk) { return static_cast<int>(OQS_KEM_kyber_512_expand_public_key(epk, pk)); };
+    auto oqs_enc_expanded = [](uint8_t* ct, uint8_t* ss, const uint8_t* epk, const uint8_t* coins) { return static_cast<int>(OQS_KEM_kyber_512_encaps_expanded_derand(ct, ss, epk, coins)); };
+    auto oqs_dec = [](uint8_t* ss, const uint8_t* ct, const uint8_t* sk) { return static_cast<int>(OQS_KEM_kyber_512_decaps(ss, ct, sk)); };
+
+    std::vector<Implementation> implementations = {
+        { "OQS", oqs_keypair, oqs_enc, oqs_expand, oqs_enc_expanded, oqs_dec },
+        { "ref", pqcrystals_kyber512_ref_keypair_derand, pqcrystals_kyber512_ref_enc_derand, pqcrystals_kyber512_ref_expand_pk,
+            pqcrystals_kyber512_ref_enc_expanded_derand, pqcrystals_kyber512_ref_dec },
+    };
+#ifdef OQS_ENABLE_KEM_kyber_512_avx2
+    if (OQS_CPU_has_extension(OQS_CPU_EXT_AVX2) && OQS_CPU_has_extension(OQS_CPU_EXT_BMI2) && OQS_CPU_has_extension(OQS_CPU_EXT_POPCNT)) {
+        implementations.push_back({ "avx2", pqcrystals_kyber512_avx2_keypair_derand, pqcrystals_kyber512_avx2_enc_derand, pqcrystals_kyber512_avx2_expand_pk,
+            pqcrystals_kyber512_avx2_enc_expanded_derand, pqcrystals_kyber512_avx2_dec });
+    }
+#endif
+
+    std::mt19937_64 rng(16);
+    auto fill = [&](uint8_t* out, std::size_t length) {
+        for (std::size_t i = 0; i < length; i++)
+            out[i] = static_cast<uint8_t>(rng());
+    };
+    for (int key = 0; key < 4; key++) {
+        uint8_t keypair_seed[OQS_KEM_kyber_512_length_keypair_seed];
+        fill(keypair_seed, sizeof(keypair_seed));
+        std::vector<uint8_t> reference_ct;
+        for (const Implementation& impl : implementations) {
+            uint8_t pk[OQS_KEM_kyber_512_length_public_key];
+            uint8_t sk[OQS_KEM_kyber_512_length_secret_key];
+            alignas(32) uint8_t expanded[OQS_KEM_kyber_512_length_expanded_public_key];
+            ASSERT_EQ(impl.keypair(pk, sk, keypair_seed), 0) << impl.name;
+            ASSERT_EQ(impl.expand(expanded, pk), 0) << impl.name;
+
+            std::mt19937_64 coin_rng(static_cast<uint64_t>(key));
+            for (int round = 0; round < 8; round++) {
+                uint8_t coins[OQS_KEM_kyber_512_length_encaps_seed];
+                for (uint8_t& c : coins)
+                    c = static_cast<uint8_t>(coin_rng());
+                uint8_t ct[OQS_KEM_kyber_512_length_ciphertext], ct_expanded[OQS_KEM_kyber_512_length_ciphertext];
+                uint8_t ss[OQS_KEM_kyber_512_length_shared_secret], ss_expanded[OQS_KEM_kyber_512_length_shared_secret];
+                uint8_t ss_decaps[OQS_KEM_kyber_512_length_shared_secret];
+                ASSERT_EQ(impl.enc(ct, ss, pk, coins), 0) << impl.name;
+                ASSERT_EQ(impl.enc_expanded(ct_expanded, ss_expanded, expanded, coins), 0) << impl.name;
+                EXPECT_EQ(std::memcmp(ct, ct_expanded, sizeof(ct)), 0) << impl.name << ", Schlüssel " << key << ", Runde " << round;
+                EXPECT_EQ(std::memcmp(ss, ss_expanded, sizeof(ss)), 0) << impl.name << ", Schlüssel " << key << ", Runde " << round;
+                ASSERT_EQ(impl.dec(ss_decaps, ct_expanded, sk), 0) << impl.name;
+                EXPECT_EQ(std::memcmp(ss_decaps, ss_expanded, sizeof(ss)), 0) << impl.name << ", Schlüssel " << key << ", Runde " << round;
+
+                // Alle Implementierungen liefern dieselben Chiffretexte
+                if (round == 0) {
+                    if (reference_ct.empty())
+                        reference_ct.assign(ct, ct + sizeof(ct));
+                    else
+                        EXPECT_EQ(std::memcmp(reference_ct.data(), ct_expanded, sizeof(ct_expanded)), 0) << impl.name << ", Schlüssel " << key;
+                }
+            }
+        }
+    }
+}
+
+// Test: Der Kapselungs-Pool füllt seinen Ring im Hintergrund und bedient Entnahmen daraus
+TEST(CronoHashTest, EncapsulationPool) {
+    CronoQuantum::EncapsulationPoolOptions options;
+    options.capacity = 64;
+    options.when_empty = CronoQuantum::PoolExhaustion::Block;
+    ASSERT_TRUE(CronoQuantum::start_encapsulation_pool(options));
+    EXPECT_FALSE(CronoQuantum::start_encapsulation_pool(options));  // Läuft bereits
+
+    // Warten, bis der Produzent den Ring gefüllt hat
+    for (int i = 0; i < 500 && CronoQuantum::encapsulation_pool_stats().depth < 64; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    auto stats = CronoQuantum::encapsulation_pool_stats();
+    EXPECT_TRUE(stats.running);
+    EXPECT_EQ(stats.capacity, 64u);
+    EXPECT_EQ(stats.depth, 64u);
+
+    std::string input = "PoolInput";
+    CronoHash::Hasher hasher({}, CronoHash::CronoVersion::V3);
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(hasher.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 2048).length(), 512);
+    }
+    stats = CronoQuantum::encapsulation_pool_stats();
+    EXPECT_EQ(stats.consumed, 20u * 32u);   // Jedes Wort aus dem Pool (blockierend bei leerem Ring)
+    EXPECT_EQ(stats.fallbacks, 0u);
+
+    // Feste Quellen umgehen den Pool und bleiben reproduzierbar
+    CronoEntropy::FixedClock clock(1, 2, 3);
+    CronoEntropy::FixedSeedEntropy entropy1(7), entropy2(7);
+    CronoHash::Hasher fixed1({}, CronoHash::CronoVersion::V2, { &clock, &entropy1 });
+    CronoHash::Hasher fixed2({}, CronoHash::CronoVersion::V2, { &clock, &entropy2 });
+    EXPECT_EQ(fixed1.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256),
+              fixed2.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256));
+    EXPECT_EQ(CronoQuantum::encapsulation_pool_stats().consumed, 20u * 32u);
+
+    CronoQuantum::stop_encapsulation_pool();
+    EXPECT_FALSE(CronoQuantum::encapsulation_pool_stats().running);
+}
+
+// Test: Der Entropie-Sammler füllt seine Ringe im Hintergrund und bedient die Pipeline daraus
+TEST(CronoHashTest, EntropyHarvester) {
+    CronoEntropy::EntropyHarvesterOptions options;
+    options.capacity = 8;
+    ASSERT_TRUE(CronoEntropy::start_entropy_harvester(options));
+    EXPECT_FALSE(CronoEntropy::start_entropy_harvester(options));  // Läuft bereits
+
+    // Warten, bis alle vier Ringe gefüllt sind
+    for (int i = 0; i < 500 && CronoEntropy::entropy_harvester_stats().depth < 4 * 8; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    auto stats = CronoEntropy::entropy_harvester_stats();
+    EXPECT_TRUE(stats.running);
+    EXPECT_EQ(stats.capacity, 8u);
+    EXPECT_EQ(stats.depth, 4u * 8u);
+    EXPECT_GE(stats.produced, 4u * 8u);
+    EXPECT_GT(stats.refill_per_second, 0.0);
+
+    // Jeder Hasher entnimmt RAM-Fingerprint, Cache-Noise und GhostSalt
+    std::string input = "HarvesterInput";
+    for (int i = 0; i < 4; i++) {
+        CronoHash::Hasher hasher;
+        EXPECT_EQ(hasher.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::ENTROPIC, 256).length(), 64u);
+    }
+    stats = CronoEntropy::entropy_harvester_stats();
+    EXPECT_EQ(stats.hits + stats.misses, 4u * 4u);
+    EXPECT_GT(stats.hits, 0u);
+
+    // Feste Quellen umgehen den Sammler
+    CronoEntropy::FixedClock clock(1, 2, 3);
+    CronoEntropy::FixedSeedEntropy entropy(11);
+    CronoHash::Hasher fixed(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3, { &clock, &entropy });
+    fixed.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::ENTROPIC, 256);
+    EXPECT_EQ(CronoEntropy::entropy_harvester_stats().hits + CronoEntropy::entropy_harvester_stats().misses, 4u * 4u);
+
+    CronoEntropy::stop_entropy_harvester();
+    EXPECT_FALSE(CronoEntropy::entropy_harvester_stats().running);
+}
+
+// Test: Worker-Pool verteilt parallel_for vollständig, hash_async liefert Ergebnisse über Future und Callback
+TEST(CronoHashTest, WorkerPoolAndAsyncHash) {
+    CronoUtils::WorkerPool pool(3);
+    EXPECT_EQ(pool.size(), 3u);
+    std::vector<int> hits(100, 0);
+    pool.parallel_for(hits.size(), [&](std::size_t i) { hits[i]++; });
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 100);
+
+    // Zeitbindung läuft auf dem gemeinsamen Pool, ohne neue Threads pro Aufruf
+    CronoUtils::WorkerPool& shared = CronoUtils::WorkerPool::shared();
+    const uint64_t before = shared.tasks_completed();
+    auto start = std::chrono::steady_clock::now();
+    CronoUtils::adaptive_binding_factor(20.0);
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(elapsed, 20.0);
+    EXPECT_LT(elapsed, 1000.0);  // Auch bei ausgelastetem Pool nicht num_threads × Bindungsdauer
+
+    // Future- und Callback-Variante
+    std::future<CronoHash::HashResult> future = CronoHash::hash_async("AsyncInput", 10.0, CronoHash::CronoMode::SECURE, 256);
+    std::promise<std::string> callback;
+    CronoHash::hash_async("AsyncInput", [&callback](CronoHash::HashResult r) { callback.set_value(r.hex()); }, 0.0, CronoHash::CronoMode::FAST, 512);
+    CronoHash::HashResult result = future.get();
+    EXPECT_EQ(result.digest.size(), 32u);
+    EXPECT_NE(result.binding_factor, 0u);
+    EXPECT_EQ(callback.get_future().get().length(), 128u);
+    // Der Zähler steigt erst nach dem Ende eines Auftrags
+    for (int i = 0; i < 500 && shared.tasks_completed() == before; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_GT(shared.tasks_completed(), before);
+}
+
+// Test: Gleichzeitige Zeitbindungen teilen sich Abtastfenster und erhalten trotzdem eigene Faktoren
+TEST(CronoHashTest, BindingSchedulerCoalescesRequests) {
+    CronoUtils::WorkerPool pool(2);
+    CronoUtils::BindingScheduler scheduler(pool, 2);
+
+    // Acht gleichzeitige Anfragen teilen sich wenige Fenster, erhalten aber eigene Faktoren
+    const int requests = 8;
+    std::vector<uint64_t> factors(requests);
+    std::vector<double> elapsed(requests);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < requests; i++) {
+        threads.emplace_back([&, i]() {
+            auto start = std::chrono::steady_clock::now();
+            factors[i] = scheduler.bind(40.0);
+            elapsed[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    auto stats = scheduler.stats();
+    EXPECT_EQ(stats.requests, static_cast<uint64_t>(requests));
+    EXPECT_EQ(stats.windows + stats.coalesced, static_cast<uint64_t>(requests));
+    EXPECT_LT(stats.windows, static_cast<uint64_t>(requests));
+    std::sort(factors.begin(), factors.end());
+    EXPECT_EQ(std::unique(factors.begin(), factors.end()), factors.end());
+    for (double ms : elapsed) {
+        EXPECT_GE(ms, 40.0);
+    }
+
+    // Eine spätere Anfrage öffnet ein neues Fenster
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    scheduler.bind(1.0);
+    EXPECT_EQ(scheduler.stats().windows, stats.windows + 1);
+
+    // Ausgelasteter Pool: kein Sampler startet vor dem Endzeitpunkt, der anfragende Thread tastet selbst ab
+    CronoUtils::WorkerPool busy_pool(2);
+    CronoUtils::BindingScheduler busy_scheduler(busy_pool, 2);
+    std::atomic<bool> release{ false };
+    for (int i = 0; i < 2; i++) {
+        busy_pool.submit([&]() {
+            while (!release.load())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+    }
+    busy_scheduler.bind(20.0);
+    EXPECT_GT(busy_scheduler.stats().samples, 0u);
+    EXPECT_EQ(busy_pool.tasks_completed(), 0u);
+    release = true;
+}
+
+// Test: ChaCha20-DRBG: RFC-8439-Testvektoren, stückweise Ausgabe, Umleitung von OQS_randombytes und Reseeding nach fork()
+TEST(CronoHashTest, ChaCha20Drbg) {
+    // Null-Schlüssel: Ausgabe beginnt bei Byte 32 des RFC-8439-Blocks 0 (die ersten 32 Bytes werden zum neuen Schlüssel)
+    uint8_t seed[32] = {};
+    CronoEntropy::ChaCha20Drbg drbg;
+    drbg.seed(seed);
+    uint8_t out[40];
+    drbg.generate(out, sizeof(out));
+    EXPECT_EQ(CronoHash::to_hex(std::as_bytes(std::span<const uint8_t>(out, sizeof(out)))),
+        "da41597c5157488d7724e03fb8d84a376a43b8f41518a11cc387b669b2ee65869f07e7be5551387a");
+
+    // Über zwei Pufferfüllungen hinweg (Bytes 960..999) bei Seed 00..1f
+    for (int i = 0; i < 32; i++) {
+        seed[i] = static_cast<uint8_t>(i);
+    }
+    drbg.seed(seed);
+    std::vector<uint8_t> stream(1000);
+    drbg.generate(stream.data(), stream.size());
+    EXPECT_EQ(CronoHash::to_hex(std::as_bytes(std::span<const uint8_t>(stream.data() + 960, 40))),
+        "5fd844af20c38ddcd79cb934b6ac59c970ec0eea9efc46491e2da0e663d74bb585988a4476723a94");
+
+    // Aufteilung der Anfragen ändert den Strom nicht
+    drbg.seed(seed);
+    std::vector<uint8_t> split(1000);
+    drbg.generate(split.data(), 10);
+    drbg.generate(split.data() + 10, 490);
+    drbg.generate(split.data() + 500, 500);
+    EXPECT_EQ(split, stream);
+    EXPECT_EQ(drbg.reseeds(), 0u);
+
+    // OQS_randombytes ohne Umleitung läuft über den DRBG des Threads
+    std::thread([]() {
+        uint8_t bytes[64];
+        OQS_randombytes(bytes, sizeof(bytes));
+        EXPECT_EQ(CronoEntropy::thread_drbg().reseeds(), 1u);
+        OQS_randombytes(bytes, sizeof(bytes));
+        EXPECT_EQ(CronoEntropy::thread_drbg().reseeds(), 1u);
+    }).join();
+
+#ifndef _WIN32
+    // Nach fork() seedet der Kindprozess neu, statt den Strom des Elternprozesses fortzusetzen
+    uint8_t warmup[16];
+    CronoEntropy::drbg_random_bytes(warmup, sizeof(warmup));
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        uint8_t bytes[32];
+        CronoEntropy::drbg_random_bytes(bytes, sizeof(bytes));
+        const bool written = write(fds[1], bytes, sizeof(bytes)) == static_cast<ssize_t>(sizeof(bytes));
+        _exit(written ? 0 : 1);
+    }
+    close(fds[1]);
+    uint8_t child_bytes[32] = {};
+    EXPECT_EQ(read(fds[0], child_bytes, sizeof(child_bytes)), static_cast<ssize_t>(sizeof(child_bytes)));
+    close(fds[0]);
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    uint8_t parent_bytes[32];
+    CronoEntropy::drbg_random_bytes(parent_bytes, sizeof(parent_bytes));
+    EXPECT_NE(std::memcmp(child_bytes, parent_bytes, sizeof(parent_bytes)), 0);
+#endif
+}
+
+// Test: Der System-Fingerabdruck wird einmal erhoben und aus der Momentaufnahme bedient
+TEST(CronoHashTest, SystemFingerprintSnapshot) {
+    CronoUtils::SystemFingerprint first = CronoUtils::system_fingerprint();
+    EXPECT_GE(first.generation, 1u);
+    EXPECT_NE(first.cpu_id, 0u);
+    EXPECT_EQ(first.cpu_id, CronoUtils::get_cpu_id());
+
+    // Wiederholte Abfragen bedienen sich aus der Momentaufnahme, ohne das System erneut zu lesen
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10000; i++) {
+        CronoUtils::SystemFingerprint again = CronoUtils::system_fingerprint();
+        ASSERT_EQ(again.generation, first.generation);
+        ASSERT_EQ(again.boot_time, first.boot_time);
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(elapsed, 200.0);
+
+    // Explizites Auffrischen erhebt neu; die Hardware-Merkmale bleiben gleich
+    CronoUtils::refresh_system_fingerprint();
+    CronoUtils::SystemFingerprint refreshed = CronoUtils::system_fingerprint();
+    EXPECT_EQ(refreshed.generation, first.generation + 1);
+    EXPECT_EQ(refreshed.cpu_id, first.cpu_id);
+    EXPECT_EQ(refreshed.bios, first.bios);
+    EXPECT_EQ(refreshed.boot_id, first.boot_id);
+    EXPECT_EQ(CronoUtils::generate_system_chain_id().length(), 16u);
+}
+
+// Test: Alle Kernel-Varianten der Kodierer liefern dieselben Zeichen und lesen sie verlustfrei zurück
+TEST(CronoHashTest, DigestEncodings) {
+    auto bytes_of = [](std::string_view s) { return std::as_bytes(std::span<const char>(s.data(), s.size())); };
+    EXPECT_EQ(CronoHash::encode(bytes_of("foobar"), CronoHash::Encoding::Hex), "666f6f626172");
+    EXPECT_EQ(CronoHash::encode(bytes_of("\xfb\xff\xfe" "foobar"), CronoHash::Encoding::Base64Url), "-__-Zm9vYmFy");
+    EXPECT_EQ(CronoHash::encode(bytes_of("foobar"), CronoHash::Encoding::Base32), "CSQPYRK1E8");
+
+    std::mt19937_64 rng(7);
+    std::vector<std::byte> input(300);
+    for (auto& b : input) b = static_cast<std::byte>(rng());
+
+    const CronoHash::EncodingLevel original = CronoHash::encoding_level();
+    for (auto encoding : { CronoHash::Encoding::Hex, CronoHash::Encoding::Base64Url, CronoHash::Encoding::Base32 }) {
+        ASSERT_TRUE(CronoHash::force_encoding_level(CronoHash::EncodingLevel::Scalar));
+        std::vector<std::string> reference;
+        for (std::size_t n = 0; n <= input.size(); n++) {
+            reference.push_back(CronoHash::encode(std::span<const std::byte>(input.data(), n), encoding));
+        }
+        for (auto level : { CronoHash::EncodingLevel::Scalar, CronoHash::EncodingLevel::SSSE3, CronoHash::EncodingLevel::AVX2 }) {
+            if (!CronoHash::force_encoding_level(level))
+                continue;
+            // Längen ohne Vielfaches der Blockgröße prüfen auch den skalaren Rest
+            for (std::size_t n = 0; n <= input.size(); n++) {
+                const std::string text = CronoHash::encode(std::span<const std::byte>(input.data(), n), encoding);
+                ASSERT_EQ(text, reference[n]) << CronoHash::encoding_name(encoding) << ", Level " << static_cast<int>(level) << ", n=" << n;
+                std::vector<std::byte> decoded(n);
+                ASSERT_EQ(CronoHash::decode_into(decoded, text, encoding), n);
+                ASSERT_TRUE(std::equal(decoded.begin(), decoded.end(), input.begin()));
+            }
+
+            // Ein ungültiges Zeichen wird an jeder Position erkannt, im SIMD-Block wie im Rest
+            const std::string valid = reference[256];
+            for (std::size_t pos = 0; pos < valid.size(); pos += 7) {
+                std::string broken = valid;
+                broken[pos] = encoding == CronoHash::Encoding::Base32 ? 'U' : '+';
+                EXPECT_TRUE(CronoHash::decode(broken, encoding).empty()) << CronoHash::encoding_name(encoding) << ", Position " << pos;
+            }
+        }
+    }
+    CronoHash::force_encoding_level(original);
+
+    // Groß-/Kleinschreibung und Crockford-Verwechslungen; nicht kanonische Endbits und Längen werden abgelehnt
+    EXPECT_EQ(CronoHash::decode("666F6F626172", CronoHash::Encoding::Hex), CronoHash::decode("666f6f626172", CronoHash::Encoding::Hex));
+    EXPECT_EQ(CronoHash::decode("csqpyrkie8", CronoHash::Encoding::Base32), CronoHash::decode("CSQPYRK1E8", CronoHash::Encoding::Base32));
+    EXPECT_EQ(CronoHash::decode("O0", CronoHash::Encoding::Base32).size(), 1u);
+    EXPECT_TRUE(CronoHash::decode("01", CronoHash::Encoding::Base32).empty());
+    EXPECT_EQ(CronoHash::decode("Zm8", CronoHash::Encoding::Base64Url).size(), 2u);
+    EXPECT_TRUE(CronoHash::decode("Zm9", CronoHash::Encoding::Base64Url).empty());
+    EXPECT_TRUE(CronoHash::decode("abc", CronoHash::Encoding::Hex).empty());
+    EXPECT_EQ(CronoHash::decoded_length(CronoHash::Encoding::Base64Url, 5), 0u);
+
+    CronoHash::HashResult result = CronoHash::hash_with_result("EncodingInput", 13, 0.0, CronoHash::CronoMode::FAST, 2048);
+    EXPECT_EQ(result.encoded(CronoHash::Encoding::Hex), result.hex());
+    EXPECT_EQ(result.encoded(CronoHash::Encoding::Base64Url).length(), 342u);
+    EXPECT_EQ(CronoHash::decode(result.encoded(CronoHash::Encoding::Base32), CronoHash::Encoding::Base32), result.digest);
+}
+
+// Test: JSON Lines: einzeilige Ausgabe mit optionalem Encoding-Feld, to_json() bleibt mehrzeilig
+TEST(CronoHashTest, JsonLines) {
+    CronoHash::HashResult result = CronoHash::hash_with_result("JsonLinesInput", 14, 0.0, CronoHash::CronoMode::SECURE, 512);
+    std::string lines;
+    CronoHash::append_json_line(lines, result);
+    CronoHash::append_json_line(lines, result, CronoHash::Encoding::Base64Url);
+    ASSERT_EQ(std::count(lines.begin(), lines.end(), '\n'), 2);
+    const std::string first = lines.substr(0, lines.find('\n'));
+    const std::string second = lines.substr(first.size() + 1, lines.size() - first.size() - 2);
+    EXPECT_EQ(first.rfind("{\"hash\": \"" + result.hex() + "\", \"tsc\": ", 0), 0u);
+    EXPECT_EQ(first.back(), '}');
+    EXPECT_EQ(second.rfind("{\"hash\": \"" + result.encoded(CronoHash::Encoding::Base64Url) + "\", \"encoding\": \"base64url\", ", 0), 0u);
+    EXPECT_NE(second.find("\"mode\": \"SECURE\", \"bit_strength\": 512, \"version\": 3}"), std::string::npos);
+
+    // Die mehrzeilige Ausgabe von to_json() bleibt unverändert
+    const std::string json = CronoHash::to_json(result);
+    EXPECT_EQ(json.rfind("{\n  \"hash\": \"" + result.hex() + "\",\n  \"tsc\": ", 0), 0u);
+    EXPECT_EQ(json.find("encoding"), std::string::npos);
+}
+
+// Test: Datei-Hashing (gemappt und doppelt gepuffert gelesen) entspricht Stream::update() über denselben Inhalt
+TEST(CronoHashTest, FileHashing) {
+    std::string content(3 * (1 << 20) + 12345, '\0');
+    std::mt19937_64 rng(25);
+    for (char& c : content) {
+        c = static_cast<char>(rng());
+    }
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "crono_file_hashing.bin";
+    {
+        std::FILE* file = std::fopen(path.string().c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(std::fwrite(content.data(), 1, content.size(), file), content.size());
+        std::fclose(file);
+    }
+
+    auto expected_hex = [&](std::string_view data) {
+        CronoEntropy::FixedClock clock(1, 2, 3);
+        CronoEntropy::FixedSeedEntropy entropy(4);
+        CronoHash::Stream stream(0, CronoHash::CronoMode::BALANCED, 256, { &clock, &entropy });
+        stream.update(data.data(), data.size());
+        return stream.final().hex();
+    };
+
+    CronoEntropy::FixedClock clock_a(1, 2, 3), clock_b(1, 2, 3);
+    CronoEntropy::FixedSeedEntropy entropy_a(4), entropy_b(4);
+    CronoHash::Stream mapped(0, CronoHash::CronoMode::BALANCED, 256, { &clock_a, &entropy_a });
+    CronoHash::FileHashStats stats;
+    ASSERT_TRUE(CronoHash::absorb_file(mapped, path.string().c_str(), &stats));
+    EXPECT_EQ(stats.bytes, content.size());
+    EXPECT_EQ(mapped.bytes_absorbed(), content.size());
+#ifndef _WIN32
+    EXPECT_TRUE(stats.mapped);
+#endif
+    EXPECT_EQ(mapped.final().hex(), expected_hex(content));
+
+    // Lesepfad über mehrere Puffer, letzter Puffer nur teilweise gefüllt
+    CronoHash::Stream streamed(0, CronoHash::CronoMode::BALANCED, 256, { &clock_b, &entropy_b });
+    std::FILE* file = std::fopen(path.string().c_str(), "rb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_TRUE(CronoHash::absorb_file_stream(streamed, file, &stats));
+    std::fclose(file);
+    EXPECT_FALSE(stats.mapped);
+    EXPECT_EQ(stats.bytes, content.size());
+    EXPECT_GE(stats.total_ms, stats.hash_ms);
+    EXPECT_EQ(streamed.final().hex(), expected_hex(content));
+
+    // Leere Datei: kein Mapping, dasselbe Ergebnis wie ein leerer Stream
+    {
+        std::FILE* empty = std::fopen(path.string().c_str(), "wb");
+        ASSERT_NE(empty, nullptr);
+        std::fclose(empty);
+    }
+    CronoEntropy::FixedClock clock_c(1, 2, 3);
+    CronoEntropy::FixedSeedEntropy entropy_c(4);
+    CronoHash::Stream empty_stream(0, CronoHash::CronoMode::BALANCED, 256, { &clock_c, &entropy_c });
+    ASSERT_TRUE(CronoHash::absorb_file(empty_stream, path.string().c_str(), &stats));
+    EXPECT_EQ(stats.bytes, 0u);
+    EXPECT_EQ(empty_stream.final().hex(), expected_hex({}));
+
+#ifndef _WIN32
+    // stdin auf eine Datei umgeleitet, von der ein Vorgänger schon gelesen hat: nur der Rest zählt,
+    // auch wenn die Position nicht auf einer Seitengrenze liegt
+    {
+        std::FILE* file = std::fopen(path.string().c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(std::fwrite(content.data(), 1, content.size(), file), content.size());
+        std::fclose(file);
+    }
+    for (std::size_t offset : { std::size_t{ 3 }, std::size_t{ 8192 }, content.size() - 5, content.size() }) {
+        const int saved = dup(STDIN_FILENO);
+        const int fd = open(path.string().c_str(), O_RDONLY);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(lseek(fd, static_cast<off_t>(offset), SEEK_SET), static_cast<off_t>(offset));
+        dup2(fd, STDIN_FILENO);
+        close(fd);
+        CronoEntropy::FixedClock clock_d(1, 2, 3);
+        CronoEntropy::FixedSeedEntropy entropy_d(4);
+        CronoHash::Stream rest(0, CronoHash::CronoMode::BALANCED, 256, { &clock_d, &entropy_d });
+        const bool ok = CronoHash::absorb_file(rest, "-", &stats);
+        const off_t end = lseek(STDIN_FILENO, 0, SEEK_CUR);
+        dup2(saved, STDIN_FILENO);
+        close(saved);
+        std::clearerr(stdin);
+        ASSERT_TRUE(ok) << "Offset " << offset;
+        EXPECT_EQ(stats.bytes, content.size() - offset) << "Offset " << offset;
+        EXPECT_EQ(end, static_cast<off_t>(content.size())) << "Offset " << offset;
+        EXPECT_EQ(rest.final().hex(), expected_hex(std::string_view(content).substr(offset))) << "Offset " << offset;
+    }
+#endif
+
+    std::filesystem::remove(path);
+    CronoHash::Stream missing;
+    EXPECT_FALSE(CronoHash::absorb_file(missing, path.string().c_str()));
+}
+
+// Test: Gebündelte Quantum-Mix-Runden entsprechen der skalaren Funktion je Wort
+TEST(CronoHashTest, BatchedQuantumMixMatchesScalar) {
+    std::mt19937_64 rng(3);
+    for (std::size_t length : { 0u, 1u, 64u, 119u, 120u, 121u, 1000u }) {
+        std::string data(length, '\0');
+        for (auto& c : data) c = static_cast<char>(rng());
+        for (std::size_t n = 0; n <= 9; n++) {
+            std::vector<uint64_t> input(n);
+            for (auto& w : input) w = rng();
+            std::vector<uint64_t> words = input;
+            CronoQuantum::quantum_mix_words(words.data(), n, data.data(), data.size());
+            for (std::size_t i = 0; i < n; i++)
+                EXPECT_EQ(words[i], input[i] ^ CronoQuantum::quantum_mix(input[i], data.data(), data.size())) << "n=" << n << " length=" << length;
+        }
+    }
+}
+
+// Test: Bitstärken außerhalb der Dispatch-Tabelle laufen über die Laufzeit-Variante
+TEST(CronoHashTest, NonTableBitStrengths) {
+    std::string input = "OddBitStrength";
+    for (unsigned int bit : { 64u, 192u, 4096u }) {
+        auto hash = CronoHash::hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::ENTROPIC, bit);
+        EXPECT_EQ(hash.length(), bit / 4) << "Fehler bei Bitstärke: " << bit;
+    }
+
+    // Jeder Eintrag der Tabelle liefert bei festen Quellen denselben Digest wie die Laufzeit-Variante (N = 0)
+    auto fixed_hash = [&](CronoHash::CronoMode mode, unsigned int bit) {
+        CronoEntropy::FixedClock clock(1, 2, 3);
+        CronoEntropy::FixedSeedEntropy entropy(8);
+        CronoHash::Hasher hasher(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3, { &clock, &entropy });
+        return hasher.hash(input.c_str(), input.length(), 0, mode, bit);
+    };
+    for (auto mode : { CronoHash::CronoMode::FAST, CronoHash::CronoMode::BALANCED, CronoHash::CronoMode::SECURE, CronoHash::CronoMode::ENTROPIC }) {
+        for (unsigned int bit : { 128u, 256u, 512u, 1024u, 2048u }) {
+            const std::string table = fixed_hash(mode, bit);
+            CronoHash::force_runtime_pipeline(true);
+            const std::string runtime = fixed_hash(mode, bit);
+            CronoHash::force_runtime_pipeline(false);
+            EXPECT_EQ(runtime, table) << "Modus " << static_cast<int>(mode) << ", Bitstärke " << bit;
+        }
+    }
+}
+
+// Zählende Ressource, die an new_delete_resource weiterreicht
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// Test: Nach dem Aufwärmen fordert hash_into() keinen Speicher mehr an (Arena, Sponge und Kyber-Sitzung bleiben bestehen)
+TEST(CronoHashTest, SteadyStateHashingAllocatesNothing) {
+    // Eine eigene Arena über einer zählenden Ressource für den einen Hasher, die Thread-Arena für den anderen
+    CountingResource counting;
+    CronoUtils::ScratchArena arena(CronoUtils::ScratchArena::DEFAULT_CAPACITY, &counting);
+    CronoHash::Hasher v3(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3, {}, &arena);
+    CronoHash::Hasher v1(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V1);
+    std::string input = "ZeroAllocationInput";
+    std::string large(1000, 'x');  // V1: Quantum-Puffer größer als der Stack-Puffer -> Thread-Arena
+    std::byte out[4096 / 8];
+
+    auto run = [&]() {
+        v3.hash_into(out, input.c_str(), input.length(), 0, CronoHash::CronoMode::BALANCED, 256);
+        v3.hash_into(out, large.c_str(), large.length(), 0, CronoHash::CronoMode::SECURE, 4096);
+        v1.hash_into(out, large.c_str(), large.length(), 0, CronoHash::CronoMode::FAST, 512);
+    };
+    for (int i = 0; i < 4; i++) run();
+    const std::size_t counted = counting.allocations;
+    const uint64_t arena_blocks = arena.upstream_allocations();
+    const uint64_t thread_blocks = CronoUtils::thread_arena().upstream_allocations();
+    EXPECT_GT(counted, 0u);
+
+    // 200 Durchläufe schließen mehrere Kyber-Schlüsselwechsel ein
+    for (int i = 0; i < 200; i++) run();
+
+    EXPECT_EQ(counting.allocations, counted);
+    EXPECT_EQ(arena.upstream_allocations(), arena_blocks);
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(CronoUtils::thread_arena().upstream_allocations(), thread_blocks);
+    EXPECT_EQ(CronoUtils::thread_arena().used(), 0u);
+}
+
+// Test: Eine eigene Scratch-Ressource erhält die Zwischenpuffer, ohne das Ergebnis zu verändern
+TEST(CronoHashTest, CustomScratchResource) {
+    std::string input = "ScratchResourceInput";
+    CountingResource counting;
+    CronoEntropy::FixedClock clock_a(1, 2, 3), clock_b(1, 2, 3);
+    CronoEntropy::FixedSeedEntropy entropy_a(9), entropy_b(9);
+    CronoHash::Hasher plain(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3, { &clock_a, &entropy_a });
+    CronoHash::Hasher routed(CronoHash::RefreshPolicy{}, CronoHash::CronoVersion::V3, { &clock_b, &entropy_b }, &counting);
+    EXPECT_EQ(routed.scratch(), &counting);
+
+    auto expected = plain.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::BALANCED, 4096);
+    auto actual = routed.hash(input.c_str(), input.length(), 0, CronoHash::CronoMode::BALANCED, 4096);
+    EXPECT_EQ(actual, expected);
+    EXPECT_GT(counting.allocations, 0u);
+
+    // pmr-Überladungen der Formatierung
+    CronoHash::HashResult result = routed.hash_with_result(input.c_str(), input.length(), 0, CronoHash::CronoMode::FAST, 256);
+    const std::size_t before = counting.allocations;
+    EXPECT_EQ(CronoHash::to_json(result, &counting), std::pmr::string(CronoHash::to_json(result).c_str()));
+    EXPECT_EQ(CronoHash::to_hex(result.digest, &counting), std::pmr::string(result.hex().c_str()));
+    EXPECT_GT(counting.allocations, before);
+}